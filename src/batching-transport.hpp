@@ -0,0 +1,392 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_BATCHING_TRANSPORT_HPP
+#define NDNTG_BATCHING_TRANSPORT_HPP
+
+#include "logger.hpp"
+#include "metrics.hpp"
+
+#include <ndn-cxx/transport/transport.hpp>
+#include <ndn-cxx/transport/unix-transport.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/write.hpp>
+
+namespace ndntg {
+
+/**
+ * \brief Transport to the local forwarder that writes the packets of one event loop pass at once.
+ *
+ * ndn::Face hands every Interest and Data to its transport separately, and the default
+ * transport writes each of them with a system call of its own. This transport instead
+ * appends the packets to a contiguous buffer, which is written by a handler posted to the
+ * io_context, i.e., after the handler that produced the packets (e.g., one Interest
+ * generation tick or one batch of received Interests) has returned. Packets queued while a
+ * write is in progress are sent together with the next write.
+ *
+ * Like the default transport, it connects to the Unix socket given by the environment
+ * variable NDN_CLIENT_TRANSPORT, or to the default socket of NFD. It can also wrap a
+ * connection accepted on the forwarder side of such a socket.
+ */
+class BatchingTransport : public ndn::Transport, public std::enable_shared_from_this<BatchingTransport>
+{
+public:
+  using CloseHandler = std::function<void()>;
+
+  struct Counters
+  {
+    uint64_t nPacketsSent = 0;
+    uint64_t nWrites = 0;
+    uint64_t nPacketsReceived = 0;
+    uint64_t nReads = 0;
+  };
+
+  explicit
+  BatchingTransport(std::string socketPath)
+    : m_socketPath(std::move(socketPath))
+  {
+  }
+
+  /**
+   * \brief Wraps an already connected socket, e.g., one accepted by a forwarder.
+   */
+  explicit
+  BatchingTransport(boost::asio::local::stream_protocol::socket&& socket)
+    : m_socket(std::move(socket))
+  {
+  }
+
+  static std::shared_ptr<BatchingTransport>
+  create()
+  {
+    const char* uri = std::getenv("NDN_CLIENT_TRANSPORT");
+    return std::make_shared<BatchingTransport>(ndn::UnixTransport::getSocketNameFromUri(uri ? uri : ""));
+  }
+
+  void
+  connect(boost::asio::io_context& ioCtx, ReceiveCallback receiveCallback) override
+  {
+    Transport::connect(ioCtx, std::move(receiveCallback));
+
+    if (!m_socket) {
+      m_socket.emplace(ioCtx);
+      boost::system::error_code ec;
+      m_socket->connect(boost::asio::local::stream_protocol::endpoint(m_socketPath), ec);
+      if (ec) {
+        m_socket.reset();
+        throw Error(ec, "cannot connect to " + m_socketPath);
+      }
+    }
+    m_isConnected = true;
+  }
+
+  void
+  close() override
+  {
+    m_isConnected = false;
+    m_isReceiving = false;
+    if (m_socket) {
+      boost::system::error_code ec;
+      m_socket->shutdown(boost::asio::socket_base::shutdown_both, ec);
+      m_socket->close(ec);
+      m_socket.reset();
+    }
+    m_pendingOutput.clear();
+    m_inputLength = 0;
+    m_isReadPending = false;
+    m_isWriting = false;
+    m_isClosePending = false;
+  }
+
+  /**
+   * \brief Stops receiving and closes the connection once all queued packets have been written.
+   */
+  void
+  shutdown()
+  {
+    m_isReceiving = false;
+    if (m_isWriting || m_isFlushScheduled) {
+      m_isClosePending = true;
+    }
+    else {
+      close();
+    }
+  }
+
+  /**
+   * \brief Sets the handler invoked when the connection fails or is closed by the peer.
+   *
+   * By default, such an event throws Error out of the io_context.
+   */
+  void
+  setCloseHandler(CloseHandler handler)
+  {
+    m_onClose = std::move(handler);
+  }
+
+  void
+  pause() override
+  {
+    // like UnixTransport, the pending read is cancelled, so that the io_context can run out of work
+    m_isReceiving = false;
+    cancelPendingRead();
+  }
+
+  void
+  resume() override
+  {
+    if (!m_isConnected || m_isReceiving) {
+      return;
+    }
+    m_isReceiving = true;
+    deliverReceivedPackets();
+    if (m_isReceiving && !m_isReadPending) {
+      receive();
+    }
+  }
+
+  void
+  send(const ndn::Block& block) override
+  {
+    if (!m_isConnected || m_isClosePending) {
+      return;
+    }
+
+    m_pendingOutput.insert(m_pendingOutput.end(), block.data(), block.data() + block.size());
+    m_counters.nPacketsSent++;
+    if (!m_isWriting && !m_isFlushScheduled) {
+      m_isFlushScheduled = true;
+      boost::asio::post(*m_ioCtx, [weak = weak_from_this()] {
+        if (auto self = weak.lock()) {
+          self->m_isFlushScheduled = false;
+          self->flush();
+        }
+      });
+    }
+  }
+
+  const Counters&
+  getCounters() const
+  {
+    return m_counters;
+  }
+
+  /**
+   * \brief Returns when the read that delivered the packets being processed completed.
+   *
+   * All packets of a read arrived no later than this, so the time that a packet spends waiting
+   * for earlier packets of the same read to be processed is measured from here.
+   */
+  std::chrono::steady_clock::time_point
+  getLastReceiveTime() const
+  {
+    return m_lastReceiveTime;
+  }
+
+private:
+  void
+  flush()
+  {
+    if (!m_socket) {
+      return;
+    }
+    if (m_pendingOutput.empty()) {
+      if (m_isClosePending) {
+        close();
+      }
+      else {
+        cancelPendingRead();
+      }
+      return;
+    }
+
+    m_output.swap(m_pendingOutput);
+    m_pendingOutput.clear();
+    m_isWriting = true;
+    m_counters.nWrites++;
+    boost::asio::async_write(*m_socket, boost::asio::buffer(m_output),
+      [weak = weak_from_this()] (const boost::system::error_code& ec, std::size_t) {
+        auto self = weak.lock();
+        if (!self || ec == boost::asio::error::operation_aborted || !self->m_isConnected) {
+          return;
+        }
+        self->m_isWriting = false;
+        if (ec) {
+          self->fail(Error(ec, "error while sending data to socket"));
+          return;
+        }
+        self->flush();
+      });
+  }
+
+  void
+  receive()
+  {
+    m_isReadPending = true;
+    m_socket->async_read_some(boost::asio::buffer(m_input.data() + m_inputLength, m_input.size() - m_inputLength),
+      [weak = weak_from_this()] (const boost::system::error_code& ec, std::size_t nBytes) {
+        auto self = weak.lock();
+        if (!self || !self->m_isConnected) {
+          return;
+        }
+        self->m_isReadPending = false;
+        if (ec == boost::asio::error::operation_aborted) {
+          // cancelled by pause(), but the transport may have been resumed meanwhile
+          if (self->m_isReceiving) {
+            self->receive();
+          }
+          return;
+        }
+        if (ec) {
+          self->fail(Error(ec, "error while receiving data from socket"));
+          return;
+        }
+
+        self->m_counters.nReads++;
+        self->m_lastReceiveTime = std::chrono::steady_clock::now();
+        self->m_inputLength += nBytes;
+        self->deliverReceivedPackets();
+        if (self->m_isReceiving) {
+          self->receive();
+        }
+      });
+  }
+
+  /**
+   * \brief Cancels the pending read while receiving is paused.
+   *
+   * Cancelling also aborts a write in progress, thus this waits until all output has been written.
+   */
+  void
+  cancelPendingRead()
+  {
+    if (m_isReceiving || !m_isReadPending || m_isWriting || m_isFlushScheduled || !m_socket) {
+      return;
+    }
+    boost::system::error_code ec;
+    m_socket->cancel(ec);
+  }
+
+  void
+  deliverReceivedPackets()
+  {
+    std::size_t offset = 0;
+    while (m_isReceiving && offset < m_inputLength) {
+      auto [isOk, block] = ndn::Block::fromBuffer(ndn::make_span(m_input.data() + offset, m_inputLength - offset));
+      if (!isOk) {
+        break;
+      }
+      offset += block.size();
+      m_counters.nPacketsReceived++;
+      m_receiveCallback(block);
+      if (!m_isConnected) {
+        return;
+      }
+    }
+
+    if (offset > 0) {
+      std::memmove(m_input.data(), m_input.data() + offset, m_inputLength - offset);
+      m_inputLength -= offset;
+    }
+    else if (m_isReceiving && m_inputLength == m_input.size()) {
+      fail(Error("received packet is larger than the receive buffer"));
+    }
+  }
+
+  void
+  fail(const Error& error)
+  {
+    close();
+    if (!m_onClose) {
+      throw error;
+    }
+    m_onClose();
+  }
+
+private:
+  const std::string m_socketPath;
+  CloseHandler m_onClose;
+  std::optional<boost::asio::local::stream_protocol::socket> m_socket;
+
+  std::vector<uint8_t> m_pendingOutput; ///< packets queued for the next write
+  std::vector<uint8_t> m_output;        ///< packets being written
+  bool m_isFlushScheduled = false;
+  bool m_isWriting = false;
+  bool m_isClosePending = false;
+
+  std::array<uint8_t, 16 * ndn::MAX_NDN_PACKET_SIZE> m_input;
+  std::size_t m_inputLength = 0;
+  bool m_isReadPending = false;
+  std::chrono::steady_clock::time_point m_lastReceiveTime;
+
+  Counters m_counters;
+};
+
+/**
+ * \brief Logs how well the packets of \p transport were batched.
+ */
+inline void
+logTransportStatistics(Logger& logger, const BatchingTransport::Counters& counters)
+{
+  using std::to_string;
+
+  auto ratio = [] (uint64_t numerator, uint64_t denominator) {
+    return to_string(denominator > 0 ? static_cast<double>(numerator) / denominator : 0.0);
+  };
+
+  logger.log("Transport Packets Sent      = " + to_string(counters.nPacketsSent), false, true);
+  logger.log("Transport Writes            = " + to_string(counters.nWrites), false, true);
+  logger.log("Average Write Batch Size    = " + ratio(counters.nPacketsSent, counters.nWrites), false, true);
+  logger.log("Transport Packets Received  = " + to_string(counters.nPacketsReceived), false, true);
+  logger.log("Transport Reads             = " + to_string(counters.nReads), false, true);
+  logger.log("Average Read Batch Size     = " + ratio(counters.nPacketsReceived, counters.nReads), false, true);
+  logger.log("System Calls per Packet     = " + ratio(counters.nWrites + counters.nReads,
+                                                      counters.nPacketsSent + counters.nPacketsReceived) + "\n",
+             false, true);
+}
+
+inline void
+writeTransportMetrics(MetricsWriter& writer, const std::string& prefix, const BatchingTransport::Counters& counters)
+{
+  auto writeCounter = [&] (const std::string& name, const std::string& help, uint64_t value) {
+    writer.writeHeader(prefix + name, "counter", help);
+    writer.writeSample(prefix + name, "", value);
+  };
+
+  writeCounter("transport_packets_sent_total", "Packets handed to the batching transport", counters.nPacketsSent);
+  writeCounter("transport_writes_total", "Batched writes to the forwarder socket", counters.nWrites);
+  writeCounter("transport_packets_received_total", "Packets received by the batching transport",
+               counters.nPacketsReceived);
+  writeCounter("transport_reads_total", "Reads from the forwarder socket", counters.nReads);
+}
+
+} // namespace ndntg
+
+#endif // NDNTG_BATCHING_TRANSPORT_HPP
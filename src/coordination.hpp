@@ -0,0 +1,340 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_COORDINATION_HPP
+#define NDNTG_COORDINATION_HPP
+
+#include "histogram.hpp"
+#include "util.hpp"
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <boost/asio/basic_socket_acceptor.hpp>
+#include <boost/asio/buffers_iterator.hpp>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/generic/stream_protocol.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/core/noncopyable.hpp>
+
+/**
+ * \file
+ *
+ * In a coordinated run, several traffic clients (the workers) connect to one coordinator,
+ * start generating traffic at the same time, and have their statistics merged into a single
+ * report. Each side sends one message per line:
+ *
+ *     worker -> coordinator:  HELLO <worker name>
+ *     coordinator -> worker:  START <start time in microseconds since the Unix epoch> <report interval in ms>
+ *     worker -> coordinator:  STATS <report>   (every report interval after the start)
+ *     coordinator -> worker:  STOP
+ *     worker -> coordinator:  FINAL <report>   (when the worker stops, for any reason)
+ *
+ * The START message is sent once all expected workers have said HELLO. Reports carry the
+ * statistics accumulated since the start, thus a lost report is superseded by the next one.
+ */
+
+namespace ndntg {
+
+using CoordinationProtocol = boost::asio::generic::stream_protocol;
+using CoordinationAcceptor = boost::asio::basic_socket_acceptor<CoordinationProtocol>;
+
+/**
+ * \brief Resolves a coordinator endpoint of the form "unix:<path>" or "<host>:<port>".
+ * \throw std::invalid_argument the endpoint is malformed
+ * \throw boost::system::system_error the host cannot be resolved
+ */
+inline CoordinationProtocol::endpoint
+resolveCoordinationEndpoint(boost::asio::io_context& io, const std::string& endpoint)
+{
+  if (endpoint.compare(0, 5, "unix:") == 0) {
+    if (endpoint.size() == 5) {
+      throw std::invalid_argument("missing socket path in '" + endpoint + "'");
+    }
+    return boost::asio::local::stream_protocol::endpoint(endpoint.substr(5));
+  }
+
+  auto pos = endpoint.rfind(':');
+  if (pos == std::string::npos || pos == 0 || pos + 1 == endpoint.size()) {
+    throw std::invalid_argument("expecting unix:<path> or <host>:<port>, not '" + endpoint + "'");
+  }
+  auto host = endpoint.substr(0, pos);
+  if (host.size() > 2 && host.front() == '[' && host.back() == ']') {
+    host = host.substr(1, host.size() - 2);
+  }
+
+  boost::asio::ip::tcp::resolver resolver(io);
+  auto results = resolver.resolve(host, endpoint.substr(pos + 1));
+  return results.begin()->endpoint();
+}
+
+/**
+ * \brief Exchanges newline-terminated messages over a stream socket.
+ *
+ * Outgoing messages are queued and written in order, so that callers never block.
+ */
+class LineChannel : public std::enable_shared_from_this<LineChannel>, boost::noncopyable
+{
+public:
+  using LineHandler = std::function<void(std::string_view line)>;
+  using CloseHandler = std::function<void()>;
+
+  explicit
+  LineChannel(CoordinationProtocol::socket&& socket)
+    : m_socket(std::move(socket))
+  {
+  }
+
+  /**
+   * \throw boost::system::system_error the connection cannot be established
+   */
+  static std::shared_ptr<LineChannel>
+  connect(boost::asio::io_context& io, const CoordinationProtocol::endpoint& endpoint)
+  {
+    CoordinationProtocol::socket socket(io);
+    socket.connect(endpoint);
+    return std::make_shared<LineChannel>(std::move(socket));
+  }
+
+  /**
+   * \brief Starts receiving messages.
+   * \param onLine invoked for each received line, without the line terminator
+   * \param onClose invoked once if the connection is closed by the peer or fails,
+   *                but not after close() has been called
+   */
+  void
+  start(LineHandler onLine, CloseHandler onClose)
+  {
+    m_onLine = std::move(onLine);
+    m_onClose = std::move(onClose);
+    receive();
+  }
+
+  void
+  send(std::string line)
+  {
+    if (m_isClosed) {
+      return;
+    }
+    line += '\n';
+    m_output.push_back(std::move(line));
+    if (m_output.size() == 1) {
+      flush();
+    }
+  }
+
+  /**
+   * \brief Writes \p line synchronously, e.g., right before the io_context is stopped.
+   * \throw boost::system::system_error the write failed
+   */
+  void
+  sendNow(std::string line)
+  {
+    if (m_isClosed) {
+      return;
+    }
+    line += '\n';
+    boost::asio::write(m_socket, boost::asio::buffer(line));
+  }
+
+  void
+  close()
+  {
+    m_isClosed = true;
+    boost::system::error_code ec;
+    m_socket.shutdown(CoordinationProtocol::socket::shutdown_both, ec);
+    m_socket.close(ec);
+  }
+
+private:
+  static constexpr std::size_t MAX_LINE_LENGTH = 1024 * 1024;
+
+  void
+  receive()
+  {
+    boost::asio::async_read_until(m_socket, m_input, '\n',
+      [this, self = shared_from_this()] (const boost::system::error_code& ec, std::size_t nBytes) {
+        if (m_isClosed) {
+          return;
+        }
+        if (ec) {
+          fail();
+          return;
+        }
+
+        std::string line(boost::asio::buffers_begin(m_input.data()),
+                         boost::asio::buffers_begin(m_input.data()) + nBytes - 1);
+        m_input.consume(nBytes);
+        if (!line.empty() && line.back() == '\r') {
+          line.pop_back();
+        }
+        m_onLine(line);
+        if (!m_isClosed) {
+          receive();
+        }
+      });
+  }
+
+  void
+  flush()
+  {
+    boost::asio::async_write(m_socket, boost::asio::buffer(m_output.front()),
+      [this, self = shared_from_this()] (const boost::system::error_code& ec, std::size_t) {
+        if (m_isClosed) {
+          return;
+        }
+        if (ec) {
+          fail();
+          return;
+        }
+        m_output.pop_front();
+        if (!m_output.empty()) {
+          flush();
+        }
+      });
+  }
+
+  void
+  fail()
+  {
+    close();
+    if (m_onClose) {
+      m_onClose();
+    }
+  }
+
+private:
+  CoordinationProtocol::socket m_socket;
+  boost::asio::streambuf m_input{MAX_LINE_LENGTH};
+  std::deque<std::string> m_output;
+  LineHandler m_onLine;
+  CloseHandler m_onClose;
+  bool m_isClosed = false;
+};
+
+/**
+ * \brief Statistics of one worker, accumulated since the start of a coordinated run.
+ */
+struct WorkerReport
+{
+  void
+  merge(const WorkerReport& other)
+  {
+    nInterestsSent += other.nInterestsSent;
+    nResponses += other.nResponses;
+    nNacks += other.nNacks;
+    nTimeouts += other.nTimeouts;
+    nContentInconsistencies += other.nContentInconsistencies;
+    serviceTime.merge(other.serviceTime);
+    responseTime.merge(other.responseTime);
+    generatorLag.merge(other.generatorLag);
+  }
+
+  /**
+   * \brief Encodes the report as space-separated key=value pairs.
+   */
+  std::string
+  encode() const
+  {
+    using std::to_string;
+
+    return "sent=" + to_string(nInterestsSent) + " responses=" + to_string(nResponses) +
+           " nacks=" + to_string(nNacks) + " timeouts=" + to_string(nTimeouts) +
+           " inconsistent=" + to_string(nContentInconsistencies) + " rtt=" + serviceTime.encode() +
+           " response=" + responseTime.encode() + " lag=" + generatorLag.encode();
+  }
+
+  /**
+   * \brief Restores a report produced by encode(); unknown keys are ignored.
+   * \return whether \p input is well formed
+   */
+  bool
+  decode(std::string_view input)
+  {
+    WorkerReport result;
+    while (!input.empty()) {
+      auto pos = input.find(' ');
+      auto pair = input.substr(0, pos);
+      input.remove_prefix(pos == std::string_view::npos ? input.size() : pos + 1);
+      if (pair.empty()) {
+        continue;
+      }
+
+      auto eq = pair.find('=');
+      if (eq == std::string_view::npos) {
+        return false;
+      }
+      auto key = pair.substr(0, eq);
+      auto value = pair.substr(eq + 1);
+
+      bool isValid = true;
+      if (key == "sent") {
+        isValid = parseNumber(value, result.nInterestsSent);
+      }
+      else if (key == "responses") {
+        isValid = parseNumber(value, result.nResponses);
+      }
+      else if (key == "nacks") {
+        isValid = parseNumber(value, result.nNacks);
+      }
+      else if (key == "timeouts") {
+        isValid = parseNumber(value, result.nTimeouts);
+      }
+      else if (key == "inconsistent") {
+        isValid = parseNumber(value, result.nContentInconsistencies);
+      }
+      else if (key == "rtt") {
+        isValid = result.serviceTime.decode(value);
+      }
+      else if (key == "response") {
+        isValid = result.responseTime.decode(value);
+      }
+      else if (key == "lag") {
+        isValid = result.generatorLag.decode(value);
+      }
+      if (!isValid) {
+        return false;
+      }
+    }
+
+    *this = std::move(result);
+    return true;
+  }
+
+  uint64_t nInterestsSent = 0;
+  uint64_t nResponses = 0;
+  uint64_t nNacks = 0;
+  uint64_t nTimeouts = 0;
+  uint64_t nContentInconsistencies = 0;
+  Histogram serviceTime;
+  Histogram responseTime;
+  Histogram generatorLag;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_COORDINATION_HPP
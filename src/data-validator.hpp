@@ -0,0 +1,231 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_DATA_VALIDATOR_HPP
+#define NDNTG_DATA_VALIDATOR_HPP
+
+#include "logger.hpp"
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/face.hpp>
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/security/certificate-fetcher-offline.hpp>
+#include <ndn-cxx/security/transform/public-key.hpp>
+#include <ndn-cxx/security/validator-config.hpp>
+#include <ndn-cxx/security/verification-helpers.hpp>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <boost/lexical_cast.hpp>
+
+namespace ndntg {
+
+/**
+ * \brief Checks the signatures of received Data, as a consumer would before using them.
+ *
+ * The DIGEST method only recomputes the SHA-256 digest of the Data. The ANCHOR method validates
+ * the Data with an ndn-cxx validator, which follows the certificate chain up to a trust anchor of
+ * its configuration, retrieving certificates as needed. Once a chain has been validated, the public
+ * key named by the KeyLocator is cached, and further Data carrying the same KeyLocator only have
+ * their signature verified with it. This is the steady state of a consumer that has already
+ * retrieved and trusted the certificates of a producer, in which the trust rules are evaluated
+ * once per key rather than once per packet.
+ */
+class DataValidator
+{
+public:
+  enum class Method {
+    NONE,
+    DIGEST,
+    ANCHOR,
+  };
+
+  static constexpr std::size_t MAX_CACHED_KEYS = 1000;
+
+  /**
+   * \brief Parses "none", "digest", or "anchor".
+   */
+  static std::optional<Method>
+  parseMethod(std::string_view value)
+  {
+    if (value == "none") {
+      return Method::NONE;
+    }
+    if (value == "digest") {
+      return Method::DIGEST;
+    }
+    if (value == "anchor") {
+      return Method::ANCHOR;
+    }
+    return std::nullopt;
+  }
+
+  static const char*
+  toString(Method method)
+  {
+    switch (method) {
+      case Method::NONE:
+        return "none";
+      case Method::DIGEST:
+        return "digest";
+      case Method::ANCHOR:
+        return "anchor";
+    }
+    return "";
+  }
+
+  /**
+   * \brief Loads the validator configuration, including its trust anchors, for the ANCHOR method.
+   * \param face retrieves the certificates of a chain; if null, only certificates that are
+   *             trust anchors can be used
+   * \throw std::exception the configuration cannot be loaded
+   */
+  void
+  load(const std::string& configFile, ndn::Face* face)
+  {
+    if (face != nullptr) {
+      m_validator = std::make_unique<ndn::security::ValidatorConfig>(*face);
+    }
+    else {
+      m_validator = std::make_unique<ndn::security::ValidatorConfig>(
+        std::make_unique<ndn::security::CertificateFetcherOffline>());
+    }
+    m_validator->load(configFile);
+    m_configFile = configFile;
+  }
+
+  bool
+  isLoaded() const
+  {
+    return m_validator != nullptr;
+  }
+
+  /**
+   * \brief Validates \p data with \p method, which must not be ANCHOR unless load() succeeded.
+   *
+   * Digest checks and signature checks with a cached key invoke a callback before returning, the
+   * callbacks are only copied when a full validation has to wait for certificates.
+   *
+   * \param onSuccess invoked as `onSuccess()`
+   * \param onFailure invoked as `onFailure(const ndn::Data& data, std::string_view reason)`
+   */
+  template<typename SuccessCallback, typename FailureCallback>
+  void
+  validate(const ndn::Data& data, Method method, SuccessCallback&& onSuccess, FailureCallback&& onFailure)
+  {
+    switch (method) {
+      case Method::NONE:
+        onSuccess();
+        return;
+      case Method::DIGEST:
+        if (ndn::security::verifyDigest(data, ndn::DigestAlgorithm::SHA256)) {
+          onSuccess();
+        }
+        else {
+          onFailure(data, "digest mismatch");
+        }
+        return;
+      case Method::ANCHOR:
+        break;
+    }
+    BOOST_ASSERT(m_validator != nullptr);
+
+    std::optional<ndn::Name> keyName;
+    const auto& sigInfo = data.getSignatureInfo();
+    if (sigInfo.hasKeyLocator() && sigInfo.getKeyLocator().getType() == ndn::tlv::Name) {
+      keyName = sigInfo.getKeyLocator().getName();
+      auto it = m_keyCache.find(*keyName);
+      if (it != m_keyCache.end()) {
+        m_nCacheHits++;
+        if (ndn::security::verifySignature(data, *it->second)) {
+          onSuccess();
+        }
+        else {
+          onFailure(data, "signature does not match the cached key of " + keyName->toUri());
+        }
+        return;
+      }
+    }
+    m_nCacheMisses++;
+
+    m_validator->validate(data,
+      [this, keyName, onSuccess] (const ndn::Data&) {
+        if (keyName) {
+          cacheKey(*keyName);
+        }
+        onSuccess();
+      },
+      [onFailure] (const ndn::Data& validatedData, const ndn::security::ValidationError& error) {
+        onFailure(validatedData, boost::lexical_cast<std::string>(error));
+      });
+  }
+
+  /**
+   * \brief Logs the validator in the report of a traffic tool, if it was loaded.
+   */
+  void
+  log(Logger& logger) const
+  {
+    if (!isLoaded()) {
+      return;
+    }
+    logger.log("Validator Configuration     = " + m_configFile, false, true);
+    logger.log("Validation Key Cache Hits   = " + std::to_string(m_nCacheHits), false, true);
+    logger.log("Validation Key Cache Misses = " + std::to_string(m_nCacheMisses) + "\n", false, true);
+  }
+
+private:
+  void
+  cacheKey(const ndn::Name& keyName)
+  {
+    // the validator keeps the certificates of the chains it has validated
+    const auto* cert = m_validator->findTrustedCert(ndn::Interest(keyName).setCanBePrefix(true));
+    if (cert == nullptr) {
+      return;
+    }
+
+    auto key = std::make_unique<ndn::security::transform::PublicKey>();
+    try {
+      key->loadPkcs8(cert->getPublicKey());
+    }
+    catch (const std::exception&) {
+      return;
+    }
+
+    if (m_keyCache.size() >= MAX_CACHED_KEYS) {
+      m_keyCache.clear();
+    }
+    m_keyCache.insert_or_assign(keyName, std::move(key));
+  }
+
+private:
+  std::unique_ptr<ndn::security::ValidatorConfig> m_validator;
+  std::string m_configFile;
+  /// public keys of validated chains, by the Name in the KeyLocator of the Data they signed
+  std::map<ndn::Name, std::unique_ptr<ndn::security::transform::PublicKey>> m_keyCache;
+  uint64_t m_nCacheHits = 0;
+  uint64_t m_nCacheMisses = 0;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_DATA_VALIDATOR_HPP
@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_DELAY_DISTRIBUTION_HPP
+#define NDNTG_DELAY_DISTRIBUTION_HPP
+
+#include "util.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/algorithm/string/trim.hpp>
+
+namespace ndntg {
+
+/**
+ * \brief Distribution of a delay, given in milliseconds as one of
+ *
+ * - `constant:<delay>`
+ * - `uniform:<min>,<max>`
+ * - `exponential:<mean>`
+ * - `lognormal:<median>,<sigma>`, where sigma is the standard deviation of the logarithm
+ * - `empirical:<file>`, which draws from the delays listed in the file, one per line
+ */
+class DelayDistribution
+{
+public:
+  /**
+   * \throw std::invalid_argument \p spec is malformed, or the file of an empirical
+   *                              distribution cannot be read or lists no delays
+   */
+  explicit
+  DelayDistribution(std::string_view spec)
+    : m_spec(spec)
+  {
+    auto colon = spec.find(':');
+    if (colon == std::string_view::npos) {
+      throw std::invalid_argument("missing ':' after the distribution type");
+    }
+    auto type = spec.substr(0, colon);
+    auto args = spec.substr(colon + 1);
+
+    auto parseArgs = [args] (std::size_t count) {
+      std::vector<double> values;
+      std::string_view rest = args;
+      while (true) {
+        auto comma = rest.find(',');
+        double value = 0.0;
+        if (!parseNumber(rest.substr(0, comma), value) || value < 0.0) {
+          throw std::invalid_argument("delays must be non-negative numbers of milliseconds");
+        }
+        values.push_back(value);
+        if (comma == std::string_view::npos) {
+          break;
+        }
+        rest.remove_prefix(comma + 1);
+      }
+      if (values.size() != count) {
+        throw std::invalid_argument("expecting " + std::to_string(count) + " parameters");
+      }
+      return values;
+    };
+
+    if (type == "constant") {
+      m_type = Type::CONSTANT;
+      m_a = parseArgs(1)[0];
+    }
+    else if (type == "uniform") {
+      m_type = Type::UNIFORM;
+      auto values = parseArgs(2);
+      m_a = values[0];
+      m_b = values[1];
+      if (m_a > m_b) {
+        throw std::invalid_argument("the minimum of a uniform distribution exceeds the maximum");
+      }
+    }
+    else if (type == "exponential") {
+      m_type = Type::EXPONENTIAL;
+      m_a = parseArgs(1)[0];
+    }
+    else if (type == "lognormal") {
+      m_type = Type::LOGNORMAL;
+      auto values = parseArgs(2);
+      if (values[0] <= 0.0) {
+        throw std::invalid_argument("the median of a lognormal distribution must be positive");
+      }
+      m_a = std::log(values[0]);
+      m_b = values[1];
+    }
+    else if (type == "empirical") {
+      m_type = Type::EMPIRICAL;
+      loadSamples(std::string(args));
+    }
+    else {
+      throw std::invalid_argument("unknown distribution '" + std::string(type) + "'");
+    }
+  }
+
+  template<typename Engine>
+  std::chrono::nanoseconds
+  operator()(Engine& engine) const
+  {
+    double ms = 0.0;
+    switch (m_type) {
+      case Type::CONSTANT:
+        ms = m_a;
+        break;
+      case Type::UNIFORM:
+        ms = std::uniform_real_distribution<double>(m_a, m_b)(engine);
+        break;
+      case Type::EXPONENTIAL:
+        ms = m_a > 0.0 ? std::exponential_distribution<double>(1.0 / m_a)(engine) : 0.0;
+        break;
+      case Type::LOGNORMAL:
+        ms = std::lognormal_distribution<double>(m_a, m_b)(engine);
+        break;
+      case Type::EMPIRICAL:
+        ms = m_samples[std::uniform_int_distribution<std::size_t>(0, m_samples.size() - 1)(engine)];
+        break;
+    }
+    return std::chrono::nanoseconds(static_cast<int64_t>(ms * 1e6));
+  }
+
+  /**
+   * \brief Returns the specification the distribution was created from.
+   */
+  const std::string&
+  toString() const
+  {
+    return m_spec;
+  }
+
+private:
+  void
+  loadSamples(const std::string& fileName)
+  {
+    std::ifstream file(fileName);
+    if (!file) {
+      throw std::invalid_argument("cannot open " + fileName);
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+      lineNumber++;
+      boost::algorithm::trim(line);
+      if (line.empty() || line.front() == '#') {
+        continue;
+      }
+      double value = 0.0;
+      if (!parseNumber(line, value) || value < 0.0) {
+        throw std::invalid_argument(fileName + ":" + std::to_string(lineNumber) +
+                                    ": expecting a non-negative number of milliseconds");
+      }
+      m_samples.push_back(value);
+    }
+    if (m_samples.empty()) {
+      throw std::invalid_argument(fileName + " lists no delays");
+    }
+  }
+
+private:
+  enum class Type {
+    CONSTANT,
+    UNIFORM,
+    EXPONENTIAL,
+    LOGNORMAL,
+    EMPIRICAL,
+  };
+
+  std::string m_spec;
+  Type m_type = Type::CONSTANT;
+  double m_a = 0.0;
+  double m_b = 0.0;
+  std::vector<double> m_samples;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_DELAY_DISTRIBUTION_HPP
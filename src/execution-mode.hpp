@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_EXECUTION_MODE_HPP
+#define NDNTG_EXECUTION_MODE_HPP
+
+#include "logger.hpp"
+#include "util.hpp"
+
+#include <cerrno>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ndntg {
+
+/**
+ * \brief Where the thread running the event loop executes, and how it waits for events.
+ *
+ * The traffic tools run all their work on a single thread. For reproducible measurements on
+ * hosts with isolated cores, this thread can be pinned to a set of CPUs, and its memory can be
+ * allocated on the NUMA node it runs on. In busy-poll mode, the event loop never sleeps in the
+ * kernel, so that the time to wake up the thread is not added to the measured latencies, at
+ * the cost of keeping one CPU fully busy.
+ */
+struct ExecutionMode
+{
+  static constexpr unsigned MAX_CPUS = 1024;
+
+  /**
+   * \brief Parses a CPU list such as "2", "0,2", or "4-7,12".
+   * \return the CPUs, or nullopt if \p input is malformed
+   */
+  static std::optional<std::set<unsigned>>
+  parseCpuList(std::string_view input)
+  {
+    std::set<unsigned> cpus;
+    while (!input.empty()) {
+      auto pos = input.find(',');
+      auto item = input.substr(0, pos);
+      input.remove_prefix(pos == std::string_view::npos ? input.size() : pos + 1);
+
+      unsigned first = 0;
+      unsigned last = 0;
+      auto dash = item.find('-');
+      if (dash == std::string_view::npos) {
+        if (!parseNumber(item, first)) {
+          return std::nullopt;
+        }
+        last = first;
+      }
+      else if (!parseNumber(item.substr(0, dash), first) || !parseNumber(item.substr(dash + 1), last) ||
+               first > last) {
+        return std::nullopt;
+      }
+      if (last >= MAX_CPUS) {
+        return std::nullopt;
+      }
+      for (auto cpu = first; cpu <= last; cpu++) {
+        cpus.insert(cpu);
+      }
+    }
+    if (cpus.empty()) {
+      return std::nullopt;
+    }
+    return cpus;
+  }
+
+  /**
+   * \brief Applies the CPU affinity and memory policy to the calling thread.
+   *
+   * Must be called before the buffers of the thread are allocated, since memory that was
+   * already touched is not migrated.
+   *
+   * \throw std::system_error the CPU affinity or the memory policy cannot be set
+   */
+  void
+  apply() const
+  {
+#ifdef __linux__
+    if (!cpus.empty()) {
+      cpu_set_t cpuSet;
+      CPU_ZERO(&cpuSet);
+      for (auto cpu : cpus) {
+        if (cpu >= CPU_SETSIZE) {
+          throw std::system_error(EINVAL, std::generic_category(), "CPU " + std::to_string(cpu));
+        }
+        CPU_SET(cpu, &cpuSet);
+      }
+      if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+        throw std::system_error(errno, std::generic_category(), "cannot set CPU affinity");
+      }
+    }
+    if (wantLocalMemory && syscall(SYS_set_mempolicy, MPOL_LOCAL, nullptr, 0) != 0) {
+      throw std::system_error(errno, std::generic_category(), "cannot set NUMA memory policy");
+    }
+#else
+    if (!cpus.empty() || wantLocalMemory) {
+      throw std::system_error(ENOTSUP, std::generic_category(),
+                              "CPU affinity and NUMA memory policy are only supported on Linux");
+    }
+#endif
+  }
+
+  /**
+   * \brief Logs the mode in the report of a traffic tool.
+   */
+  void
+  log(Logger& logger) const
+  {
+    using namespace std::string_literals;
+
+    std::string cpuList;
+    for (auto cpu : cpus) {
+      cpuList += (cpuList.empty() ? "" : ",") + std::to_string(cpu);
+    }
+
+    std::string memoryPolicy = "default";
+    if (wantLocalMemory) {
+      memoryPolicy = "local NUMA node";
+#ifdef __linux__
+      unsigned cpu = 0;
+      unsigned node = 0;
+      if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+        memoryPolicy += " (node " + std::to_string(node) + ")";
+      }
+#endif
+    }
+
+    logger.log("Event Loop                  = "s + (wantBusyPoll ? "busy-poll" : "blocking"), false, true);
+    logger.log("CPU Affinity                = " + (cpuList.empty() ? "any" : cpuList), false, true);
+    logger.log("Memory Policy               = " + memoryPolicy + "\n", false, true);
+  }
+
+  std::set<unsigned> cpus; ///< CPUs the event loop may run on; empty means any
+  bool wantLocalMemory = false;
+  bool wantBusyPoll = false;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_EXECUTION_MODE_HPP
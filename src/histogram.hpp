@@ -0,0 +1,271 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_HISTOGRAM_HPP
+#define NDNTG_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ndntg {
+
+/**
+ * \brief Log-linear histogram of durations.
+ *
+ * Values are recorded with microsecond granularity into buckets that cover each power
+ * of two with 16 linear sub-buckets, which bounds the relative error to about 6%.
+ * Values larger than about 71 minutes are clamped into the last bucket.
+ *
+ * Bucket storage is allocated on the first call to record(), so that histograms
+ * that are never used (e.g., those of idle traffic patterns) remain cheap.
+ */
+class Histogram
+{
+public:
+  void
+  record(std::chrono::nanoseconds value)
+  {
+    if (m_buckets.empty()) {
+      m_buckets.resize(N_BUCKETS);
+    }
+
+    auto ns = static_cast<uint64_t>(std::max<std::chrono::nanoseconds::rep>(value.count(), 0));
+    m_buckets[getBucketIndex(std::min(ns / 1000, MAX_VALUE))]++;
+    m_count++;
+    m_sum += ns;
+    m_min = std::min(m_min, ns);
+    m_max = std::max(m_max, ns);
+  }
+
+  void
+  merge(const Histogram& other)
+  {
+    if (other.m_count == 0) {
+      return;
+    }
+    if (m_buckets.empty()) {
+      m_buckets.resize(N_BUCKETS);
+    }
+    for (std::size_t i = 0; i < N_BUCKETS; i++) {
+      m_buckets[i] += other.m_buckets[i];
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+  }
+
+  void
+  reset()
+  {
+    *this = {};
+  }
+
+  uint64_t
+  getCount() const
+  {
+    return m_count;
+  }
+
+  std::chrono::nanoseconds
+  getSum() const
+  {
+    return std::chrono::nanoseconds(m_sum);
+  }
+
+  std::chrono::nanoseconds
+  getMin() const
+  {
+    return std::chrono::nanoseconds(m_count > 0 ? m_min : 0);
+  }
+
+  std::chrono::nanoseconds
+  getMax() const
+  {
+    return std::chrono::nanoseconds(m_max);
+  }
+
+  std::chrono::nanoseconds
+  getMean() const
+  {
+    return std::chrono::nanoseconds(m_count > 0 ? m_sum / m_count : 0);
+  }
+
+  /**
+   * \brief Returns an upper bound of the \p percentile -th percentile (0 < percentile <= 100).
+   *
+   * The result is the highest value of the bucket containing the requested rank,
+   * capped to the largest recorded value.
+   */
+  std::chrono::nanoseconds
+  getPercentile(double percentile) const
+  {
+    if (m_count == 0) {
+      return std::chrono::nanoseconds(0);
+    }
+
+    auto rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * m_count));
+    rank = std::clamp<uint64_t>(rank, 1, m_count);
+    uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < N_BUCKETS; i++) {
+      cumulative += m_buckets[i];
+      if (cumulative >= rank) {
+        return std::min(std::chrono::nanoseconds(getBucketHighest(i) * 1000 + 999), getMax());
+      }
+    }
+    return getMax();
+  }
+
+  /**
+   * \brief Returns the number of recorded values that are not greater than \p bound.
+   *
+   * The result is exact when \p bound falls on a bucket boundary, otherwise values sharing
+   * the bucket that straddles \p bound are excluded.
+   */
+  uint64_t
+  getCountAtOrBelow(std::chrono::nanoseconds bound) const
+  {
+    if (m_count == 0 || bound.count() < 0) {
+      return 0;
+    }
+
+    auto us = static_cast<uint64_t>(bound.count()) / 1000;
+    uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < N_BUCKETS && getBucketHighest(i) <= us; i++) {
+      cumulative += m_buckets[i];
+    }
+    return cumulative;
+  }
+
+  /**
+   * \brief Encodes the histogram as a single-line string without spaces.
+   *
+   * The format is "count,sum,min,max" followed by ",index:count" for every non-empty bucket.
+   */
+  std::string
+  encode() const
+  {
+    std::string str = std::to_string(m_count) + ',' + std::to_string(m_sum) + ',' +
+                      std::to_string(m_min) + ',' + std::to_string(m_max);
+    for (std::size_t i = 0; i < m_buckets.size(); i++) {
+      if (m_buckets[i] > 0) {
+        str += ',' + std::to_string(i) + ':' + std::to_string(m_buckets[i]);
+      }
+    }
+    return str;
+  }
+
+  /**
+   * \brief Restores a histogram produced by encode().
+   * \return whether \p input is well formed; the histogram is unchanged otherwise
+   */
+  bool
+  decode(std::string_view input)
+  {
+    auto next = [&input] (uint64_t& value, char delimiter) {
+      auto [end, ec] = std::from_chars(input.data(), input.data() + input.size(), value);
+      if (ec != std::errc()) {
+        return false;
+      }
+      input.remove_prefix(end - input.data());
+      if (input.empty()) {
+        return true;
+      }
+      if (input[0] != delimiter) {
+        return false;
+      }
+      input.remove_prefix(1);
+      return true;
+    };
+
+    Histogram result;
+    if (!next(result.m_count, ',') || !next(result.m_sum, ',') ||
+        !next(result.m_min, ',') || !next(result.m_max, ',')) {
+      return false;
+    }
+    uint64_t total = 0;
+    while (!input.empty()) {
+      uint64_t index = 0;
+      uint64_t count = 0;
+      if (!next(index, ':') || input.empty() || !next(count, ',') || index >= N_BUCKETS) {
+        return false;
+      }
+      if (result.m_buckets.empty()) {
+        result.m_buckets.resize(N_BUCKETS);
+      }
+      result.m_buckets[index] += count;
+      total += count;
+    }
+    if (total != result.m_count) {
+      return false;
+    }
+
+    *this = std::move(result);
+    return true;
+  }
+
+private:
+  static constexpr unsigned SUB_BUCKET_BITS = 4;
+  static constexpr uint64_t N_SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  static constexpr uint64_t MAX_VALUE = std::numeric_limits<uint32_t>::max(); // in microseconds
+  static constexpr std::size_t N_BUCKETS = (32 - SUB_BUCKET_BITS + 1) * N_SUB_BUCKETS;
+
+  static constexpr std::size_t
+  getBucketIndex(uint64_t value)
+  {
+    if (value < N_SUB_BUCKETS) {
+      return value;
+    }
+    unsigned msb = 63 - __builtin_clzll(value);
+    unsigned shift = msb - SUB_BUCKET_BITS;
+    return (shift + 1) * N_SUB_BUCKETS + ((value >> shift) - N_SUB_BUCKETS);
+  }
+
+  static constexpr uint64_t
+  getBucketLowest(std::size_t index)
+  {
+    if (index < N_SUB_BUCKETS) {
+      return index;
+    }
+    auto shift = index / N_SUB_BUCKETS - 1;
+    return (index % N_SUB_BUCKETS + N_SUB_BUCKETS) << shift;
+  }
+
+  static constexpr uint64_t
+  getBucketHighest(std::size_t index)
+  {
+    return getBucketLowest(index + 1) - 1;
+  }
+
+  std::vector<uint64_t> m_buckets;
+  uint64_t m_count = 0;
+  uint64_t m_sum = 0; // in nanoseconds
+  uint64_t m_min = std::numeric_limits<uint64_t>::max();
+  uint64_t m_max = 0;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_HISTOGRAM_HPP
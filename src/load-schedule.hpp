@@ -0,0 +1,326 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_LOAD_SCHEDULE_HPP
+#define NDNTG_LOAD_SCHEDULE_HPP
+
+#include "util.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <boost/math/constants/constants.hpp>
+
+namespace ndntg {
+
+/**
+ * \brief One phase of a load schedule, i.e., a time-varying target Interest rate.
+ */
+class LoadPhase
+{
+public:
+  enum class Profile {
+    CONSTANT,
+    RAMP,
+    SINE,
+    TRACE,
+  };
+
+  void
+  printTrafficConfiguration(Logger& logger) const
+  {
+    std::ostringstream os;
+
+    if (!m_label.empty()) {
+      os << "Label=" << m_label << ", ";
+    }
+    os << "Duration=" << m_duration.count() << ", ";
+    switch (m_profile) {
+      case Profile::CONSTANT:
+        os << "Profile=constant, Rate=" << m_rate;
+        break;
+      case Profile::RAMP:
+        os << "Profile=ramp, StartRate=" << m_startRate << ", EndRate=" << m_endRate;
+        break;
+      case Profile::SINE:
+        os << "Profile=sine, Rate=" << m_rate << ", Amplitude=" << m_amplitude
+           << ", Period=" << m_period.count();
+        break;
+      case Profile::TRACE:
+        os << "Profile=trace, RateTrace=" << m_traceFile << " (" << m_trace.size() << " steps)";
+        break;
+    }
+
+    logger.log(os.str(), false, false);
+  }
+
+  bool
+  parseConfigurationLine(std::string_view parameter, std::string_view value, Logger& logger, int lineNumber)
+  {
+    auto parseRate = [&] (double& rate) {
+      if (!parseNumber(value, rate) || rate < 0.0) {
+        return reportConfigurationError(logger, lineNumber, std::string(parameter) +
+                                        " must be a non-negative number");
+      }
+      return true;
+    };
+    auto parseMilliseconds = [&] (std::chrono::milliseconds& duration) {
+      uint64_t ms = 0;
+      if (!parseNumber(value, ms) || ms == 0 || ms > MAX_DURATION_MS) {
+        return reportConfigurationError(logger, lineNumber, std::string(parameter) + " must be between 1 and " +
+                                        std::to_string(MAX_DURATION_MS) + " milliseconds");
+      }
+      duration = std::chrono::milliseconds(ms);
+      return true;
+    };
+
+    if (parameter == "Label") {
+      m_label = value;
+    }
+    else if (parameter == "Duration") {
+      return parseMilliseconds(m_duration);
+    }
+    else if (parameter == "Profile") {
+      if (value == "constant") {
+        m_profile = Profile::CONSTANT;
+      }
+      else if (value == "ramp") {
+        m_profile = Profile::RAMP;
+      }
+      else if (value == "sine") {
+        m_profile = Profile::SINE;
+      }
+      else if (value == "trace") {
+        m_profile = Profile::TRACE;
+      }
+      else {
+        return reportConfigurationError(logger, lineNumber, "Unknown profile: " + std::string(value));
+      }
+    }
+    else if (parameter == "Rate") {
+      return parseRate(m_rate);
+    }
+    else if (parameter == "StartRate") {
+      return parseRate(m_startRate);
+    }
+    else if (parameter == "EndRate") {
+      return parseRate(m_endRate);
+    }
+    else if (parameter == "Amplitude") {
+      return parseRate(m_amplitude);
+    }
+    else if (parameter == "Period") {
+      return parseMilliseconds(m_period);
+    }
+    else if (parameter == "RateTrace") {
+      m_traceFile = value;
+      if (!loadRateTrace(logger)) {
+        return false;
+      }
+    }
+    else {
+      logger.log("Line " + std::to_string(lineNumber) + " - Ignoring unknown parameter: " +
+                 std::string(parameter), false, true);
+    }
+    return true;
+  }
+
+  bool
+  checkTrafficDetailCorrectness(Logger& logger, int lineNumber) const
+  {
+    if (m_duration <= std::chrono::milliseconds::zero()) {
+      return reportConfigurationError(logger, lineNumber, "Phase has no Duration");
+    }
+    if (m_profile == Profile::SINE && m_period <= std::chrono::milliseconds::zero()) {
+      return reportConfigurationError(logger, lineNumber, "Sine phase has no Period");
+    }
+    if (m_profile == Profile::TRACE && m_trace.empty()) {
+      return reportConfigurationError(logger, lineNumber, "Trace phase has no RateTrace");
+    }
+    return true;
+  }
+
+  /**
+   * \brief Returns the target rate in Interests per second at \p elapsed since the start of the phase.
+   */
+  double
+  getRate(std::chrono::nanoseconds elapsed) const
+  {
+    double t = std::chrono::duration<double>(elapsed).count();
+    switch (m_profile) {
+      case Profile::CONSTANT:
+        return m_rate;
+      case Profile::RAMP:
+        return m_startRate + (m_endRate - m_startRate) * t /
+                             std::chrono::duration<double>(m_duration).count();
+      case Profile::SINE:
+        return std::max(0.0, m_rate + m_amplitude * std::sin(boost::math::double_constants::two_pi * t /
+                                                             std::chrono::duration<double>(m_period).count()));
+      case Profile::TRACE: {
+        auto it = std::upper_bound(m_trace.begin(), m_trace.end(), elapsed,
+                                   [] (auto lhs, const auto& step) { return lhs < step.first; });
+        return it == m_trace.begin() ? 0.0 : std::prev(it)->second;
+      }
+    }
+    return 0.0;
+  }
+
+  /**
+   * \brief Returns the target rate averaged over the whole phase.
+   */
+  double
+  getMeanRate() const
+  {
+    constexpr int N_SAMPLES = 1000;
+    auto step = std::chrono::duration_cast<std::chrono::nanoseconds>(m_duration) / N_SAMPLES;
+    double sum = 0.0;
+    for (int i = 0; i < N_SAMPLES; i++) {
+      sum += getRate(step * i + step / 2);
+    }
+    return sum / N_SAMPLES;
+  }
+
+  std::string
+  getLabel() const
+  {
+    return m_label;
+  }
+
+  std::chrono::milliseconds
+  getDuration() const
+  {
+    return m_duration;
+  }
+
+private:
+  static constexpr uint64_t MAX_DURATION_MS = 365ULL * 24 * 3600 * 1000; // one year
+
+  /**
+   * \brief Reads a rate trace, i.e., lines of "<offset in milliseconds> <Interests per second>".
+   *
+   * The rate is held constant between consecutive offsets. Empty lines and lines starting
+   * with '#' are ignored.
+   */
+  bool
+  loadRateTrace(Logger& logger)
+  {
+    std::ifstream traceFile(m_traceFile);
+    if (!traceFile) {
+      logger.log("ERROR: Unable to open rate trace file: " + m_traceFile, false, true);
+      return false;
+    }
+
+    m_trace.clear();
+    int lineNumber = 0;
+    std::string line;
+    while (std::getline(traceFile, line)) {
+      lineNumber++;
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+
+      std::istringstream is(line);
+      uint64_t offset = 0;
+      double rate = 0.0;
+      if (!(is >> offset >> rate) || !std::isfinite(rate) || rate < 0.0 ||
+          (!m_trace.empty() && std::chrono::milliseconds(offset) < m_trace.back().first)) {
+        logger.log(m_traceFile + ":" + std::to_string(lineNumber) + " - Invalid rate trace entry: " + line,
+                   false, true);
+        return false;
+      }
+      m_trace.emplace_back(std::chrono::milliseconds(offset), rate);
+    }
+    return true;
+  }
+
+private:
+  std::string m_label;
+  std::chrono::milliseconds m_duration{0};
+  Profile m_profile = Profile::CONSTANT;
+  double m_rate = 0.0;
+  double m_startRate = 0.0;
+  double m_endRate = 0.0;
+  double m_amplitude = 0.0;
+  std::chrono::milliseconds m_period{0};
+  std::string m_traceFile;
+  std::vector<std::pair<std::chrono::nanoseconds, double>> m_trace;
+};
+
+/**
+ * \brief A sequence of load phases that are followed one after another.
+ */
+class LoadSchedule
+{
+public:
+  struct Position
+  {
+    std::size_t phaseId;
+    double rate;
+    /// time remaining until the end of the phase
+    std::chrono::nanoseconds remaining;
+  };
+
+  bool
+  load(const std::string& filename, Logger& logger)
+  {
+    if (!readConfigurationFile(filename, m_phases, logger)) {
+      return false;
+    }
+    if (m_phases.empty()) {
+      logger.log("ERROR: No valid phase in load schedule file: " + filename, false, true);
+      return false;
+    }
+    return true;
+  }
+
+  const std::vector<LoadPhase>&
+  getPhases() const
+  {
+    return m_phases;
+  }
+
+  /**
+   * \brief Locates \p elapsed (measured from the start of the schedule) within the schedule.
+   * \return the current phase and target rate, or nullopt if the schedule has ended
+   */
+  std::optional<Position>
+  locate(std::chrono::nanoseconds elapsed) const
+  {
+    for (std::size_t i = 0; i < m_phases.size(); i++) {
+      std::chrono::nanoseconds duration = m_phases[i].getDuration();
+      if (elapsed < duration) {
+        return Position{i, m_phases[i].getRate(elapsed), duration - elapsed};
+      }
+      elapsed -= duration;
+    }
+    return std::nullopt;
+  }
+
+private:
+  std::vector<LoadPhase> m_phases;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_LOAD_SCHEDULE_HPP
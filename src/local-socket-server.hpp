@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_LOCAL_SOCKET_SERVER_HPP
+#define NDNTG_LOCAL_SOCKET_SERVER_HPP
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <boost/asio/buffers_iterator.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/core/noncopyable.hpp>
+
+namespace ndntg {
+
+/**
+ * \brief Line-oriented request/response server on a Unix stream socket.
+ *
+ * Each line received from a connected peer is passed to the request handler and the
+ * returned string is written back. All processing happens on the io_context that owns
+ * the server, therefore handlers may freely access the state of the traffic tool.
+ */
+class LocalSocketServer : boost::noncopyable
+{
+public:
+  /**
+   * \brief Handles one request line (without the terminating newline) and returns the response.
+   *
+   * An empty request with \p isEof set is delivered if the peer closes its sending side
+   * without writing a complete line.
+   */
+  using RequestHandler = std::function<std::string(std::string_view request, bool isEof)>;
+
+  /**
+   * \param io the io_context on which connections are serviced
+   * \param path filesystem path of the socket; a stale socket file is removed
+   * \param handler the request handler
+   * \param isOneShot if true, each connection is closed after the first response
+   */
+  LocalSocketServer(boost::asio::io_context& io, std::string path,
+                    RequestHandler handler, bool isOneShot)
+    : m_acceptor(io)
+    , m_path(std::move(path))
+    , m_handler(std::move(handler))
+    , m_isOneShot(isOneShot)
+  {
+  }
+
+  ~LocalSocketServer()
+  {
+    stop();
+  }
+
+  /**
+   * \brief Binds the socket and starts accepting connections.
+   * \throw boost::system::system_error the socket cannot be created
+   */
+  void
+  start()
+  {
+    std::error_code ec;
+    if (std::filesystem::is_socket(m_path, ec)) {
+      std::filesystem::remove(m_path, ec);
+    }
+
+    Protocol::endpoint endpoint(m_path);
+    m_acceptor.open(endpoint.protocol());
+    m_acceptor.bind(endpoint);
+    m_acceptor.listen();
+    accept();
+  }
+
+  /**
+   * \brief Stops accepting connections and removes the socket; sessions in progress complete.
+   */
+  void
+  stop()
+  {
+    if (m_acceptor.is_open()) {
+      boost::system::error_code ec;
+      m_acceptor.close(ec);
+      std::error_code fsEc;
+      std::filesystem::remove(m_path, fsEc);
+    }
+  }
+
+  const std::string&
+  getPath() const
+  {
+    return m_path;
+  }
+
+private:
+  using Protocol = boost::asio::local::stream_protocol;
+
+  static constexpr std::size_t MAX_REQUEST_LENGTH = 4096;
+
+  struct Session
+  {
+    explicit
+    Session(Protocol::socket&& s)
+      : socket(std::move(s))
+    {
+    }
+
+    Protocol::socket socket;
+    boost::asio::streambuf input{MAX_REQUEST_LENGTH};
+    std::string output;
+  };
+
+  void
+  accept()
+  {
+    m_acceptor.async_accept([this] (const boost::system::error_code& ec, Protocol::socket socket) {
+      if (ec == boost::asio::error::operation_aborted) {
+        return;
+      }
+      if (!ec) {
+        receive(std::make_shared<Session>(std::move(socket)));
+      }
+      accept();
+    });
+  }
+
+  void
+  receive(std::shared_ptr<Session> session)
+  {
+    boost::asio::async_read_until(session->socket, session->input, '\n',
+      [this, session] (const boost::system::error_code& ec, std::size_t nBytes) {
+        bool isEof = ec == boost::asio::error::eof;
+        if (ec && !(isEof && m_isOneShot)) {
+          return;
+        }
+
+        std::string line;
+        if (nBytes > 0) {
+          line.assign(boost::asio::buffers_begin(session->input.data()),
+                      boost::asio::buffers_begin(session->input.data()) + nBytes - 1);
+          session->input.consume(nBytes);
+          if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+          }
+        }
+
+        session->output = m_handler(line, isEof);
+        boost::asio::async_write(session->socket, boost::asio::buffer(session->output),
+          [this, session] (const boost::system::error_code& ec, std::size_t) {
+            if (!ec && !m_isOneShot) {
+              receive(session);
+            }
+          });
+      });
+  }
+
+private:
+  Protocol::acceptor m_acceptor;
+  const std::string m_path;
+  const RequestHandler m_handler;
+  const bool m_isOneShot;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_LOCAL_SOCKET_SERVER_HPP
@@ -22,12 +22,16 @@
 #define NDNTG_LOGGER_HPP
 
 #include <cstdlib>
+#include <ctime>
 #include <filesystem>
 #include <fstream>
+#include <locale>
+#include <sstream>
 #include <string>
 #include <string_view>
 
 #include <boost/container/static_vector.hpp>
+#include <boost/date_time/c_local_time_adjustor.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 #include <ndn-cxx/util/time.hpp>
@@ -55,18 +59,9 @@ public:
     }
 
     if (printTimestamp) {
-      if (m_wantUnixTime) {
-        using namespace ndn::time;
-        auto now = std::to_string(toUnixTimestamp<microseconds>(system_clock::now()).count() / 1e6);
-        for (auto dest : destinations) {
-          dest.get() << '[' << now << "] ";
-        }
-      }
-      else {
-        auto now = boost::posix_time::microsec_clock::local_time();
-        for (auto dest : destinations) {
-          dest.get() << '[' << now << "] ";
-        }
+      const auto& timestamp = formatTimestamp();
+      for (auto dest : destinations) {
+        dest.get() << timestamp;
       }
     }
 
@@ -75,13 +70,25 @@ public:
     }
   }
 
+  /**
+   * \brief Takes the timestamps of log lines from a coarse clock.
+   *
+   * The coarse clock is cheaper to read, and only advances once per kernel tick (typically
+   * every 1 to 4 ms), thus the formatted timestamp is reused by all lines logged within a tick.
+   */
+  void
+  setCoarseTimestamps()
+  {
+    m_wantCoarseTime = true;
+  }
+
   void
   initialize(const std::string& instanceId, const std::string& timestampFormat)
   {
     m_wantUnixTime = timestampFormat.empty();
     if (!timestampFormat.empty()) {
-      std::cout.imbue(std::locale(std::cout.getloc(),
-                                  new boost::posix_time::time_facet(timestampFormat.data())));
+      m_timestampLocale = std::locale(std::locale::classic(),
+                                      new boost::posix_time::time_facet(timestampFormat.data()));
     }
 
     m_logLocation = "";
@@ -100,10 +107,6 @@ public:
         auto logfile = logdir / (m_module + '_' + instanceId + ".log");
         m_logFile.open(logfile.string(), std::ofstream::out | std::ofstream::trunc);
         if (m_logFile.is_open()) {
-          if (!timestampFormat.empty()) {
-            m_logFile.imbue(std::locale(m_logFile.getloc(),
-                                        new boost::posix_time::time_facet(timestampFormat.data())));
-          }
           std::cout << "Log file initialized: " << logfile << std::endl;
         }
         else {
@@ -125,11 +128,52 @@ public:
     }
   }
 
+private:
+  /**
+   * \brief Returns the current time formatted as a log line prefix.
+   */
+  const std::string&
+  formatTimestamp()
+  {
+    using namespace ndn::time;
+
+    auto now = system_clock::now();
+#ifdef CLOCK_REALTIME_COARSE
+    if (m_wantCoarseTime) {
+      timespec ts;
+      clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+      now = system_clock::time_point(duration_cast<system_clock::duration>(seconds(ts.tv_sec) +
+                                                                          nanoseconds(ts.tv_nsec)));
+      if (now == m_lastTimestamp) {
+        return m_timestamp;
+      }
+    }
+#endif
+    m_lastTimestamp = now;
+
+    if (m_wantUnixTime) {
+      m_timestamp = '[' + std::to_string(toUnixTimestamp<microseconds>(now).count() / 1e6) + "] ";
+    }
+    else {
+      auto utc = boost::posix_time::from_time_t(0) +
+                 boost::posix_time::microseconds(toUnixTimestamp<microseconds>(now).count());
+      std::ostringstream os;
+      os.imbue(m_timestampLocale);
+      os << '[' << boost::date_time::c_local_adjustor<boost::posix_time::ptime>::utc_to_local(utc) << "] ";
+      m_timestamp = os.str();
+    }
+    return m_timestamp;
+  }
+
 private:
   const std::string m_module;
   std::string m_logLocation;
   std::ofstream m_logFile;
+  std::locale m_timestampLocale;
+  std::string m_timestamp;
+  ndn::time::system_clock::time_point m_lastTimestamp;
   bool m_wantUnixTime = true;
+  bool m_wantCoarseTime = false;
 };
 
 } // namespace ndntg
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_MAPPED_FILE_HPP
+#define NDNTG_MAPPED_FILE_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <boost/core/noncopyable.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ndntg {
+
+/**
+ * \brief Read-only memory mapping of a whole file, intended for sequential access.
+ *
+ * Files of any size can be processed without reading them into memory; pages that have
+ * already been consumed can be handed back to the kernel with discard().
+ *
+ * Pipes, e.g., a FIFO or a process substitution, cannot be mapped; they are read into
+ * memory as a whole instead.
+ */
+class MappedFile : boost::noncopyable
+{
+public:
+  /**
+   * \throw std::system_error the file cannot be opened, mapped, or read
+   */
+  explicit
+  MappedFile(const std::string& filename)
+  {
+    int fd = ::open(filename.data(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), filename);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), filename);
+    }
+
+    if (!S_ISREG(st.st_mode)) {
+      readAll(fd, filename);
+      ::close(fd);
+      return;
+    }
+
+    m_size = static_cast<std::size_t>(st.st_size);
+    if (m_size > 0) {
+      void* addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr == MAP_FAILED) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), filename);
+      }
+      m_data = static_cast<const char*>(addr);
+      m_isMapped = true;
+      ::madvise(addr, m_size, MADV_SEQUENTIAL);
+    }
+    ::close(fd);
+  }
+
+  ~MappedFile()
+  {
+    if (m_isMapped) {
+      ::munmap(const_cast<char*>(m_data), m_size);
+    }
+  }
+
+  std::string_view
+  getContents() const
+  {
+    return {m_data, m_size};
+  }
+
+  /**
+   * \brief Tells the kernel that the first \p length bytes of the file will not be accessed again.
+   */
+  void
+  discard(std::size_t length)
+  {
+    static const std::size_t pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    length -= length % pageSize;
+    if (m_isMapped && length > 0) {
+      ::madvise(const_cast<char*>(m_data), std::min(length, m_size), MADV_DONTNEED);
+    }
+  }
+
+private:
+  void
+  readAll(int fd, const std::string& filename)
+  {
+    char chunk[64 * 1024];
+    while (true) {
+      auto nRead = ::read(fd, chunk, sizeof(chunk));
+      if (nRead < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), filename);
+      }
+      if (nRead == 0) {
+        break;
+      }
+      m_buffer.append(chunk, static_cast<std::size_t>(nRead));
+    }
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+  }
+
+private:
+  const char* m_data = nullptr;
+  std::size_t m_size = 0;
+  bool m_isMapped = false;
+  std::string m_buffer; ///< contents of a file that cannot be mapped
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_MAPPED_FILE_HPP
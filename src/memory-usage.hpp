@@ -0,0 +1,205 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_MEMORY_USAGE_HPP
+#define NDNTG_MEMORY_USAGE_HPP
+
+#include "logger.hpp"
+#include "metrics.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+
+namespace ndntg {
+
+namespace detail {
+
+inline std::atomic<uint64_t> g_nAllocations{0};
+inline std::atomic<uint64_t> g_nDeallocations{0};
+
+inline void*
+countedAllocate(std::size_t size)
+{
+  g_nAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (auto* ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+inline void*
+countedAllocate(std::size_t size, std::align_val_t alignment)
+{
+  g_nAllocations.fetch_add(1, std::memory_order_relaxed);
+  auto align = static_cast<std::size_t>(alignment);
+  // aligned_alloc requires the size to be a non-zero multiple of the alignment
+  auto alignedSize = size == 0 ? align : (size + align - 1) / align * align;
+  if (auto* ptr = std::aligned_alloc(align, alignedSize); ptr != nullptr) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+inline void
+countedFree(void* ptr) noexcept
+{
+  if (ptr != nullptr) {
+    g_nDeallocations.fetch_add(1, std::memory_order_relaxed);
+    std::free(ptr);
+  }
+}
+
+} // namespace detail
+
+/**
+ * \brief Snapshot of the memory footprint of the process.
+ *
+ * The resident set sizes are read from /proc, thus they are zero on other platforms. Heap
+ * allocations are counted by the replacements of the global operator new and operator delete
+ * at the end of this header, which is why it must be included by exactly one translation unit
+ * of a program; each traffic tool is built from a single one. Allocations made with malloc,
+ * e.g., inside the C libraries that ndn-cxx uses, are not counted.
+ */
+struct MemoryUsage
+{
+  static MemoryUsage
+  read()
+  {
+    MemoryUsage usage;
+    usage.nAllocations = detail::g_nAllocations.load(std::memory_order_relaxed);
+    usage.nDeallocations = detail::g_nDeallocations.load(std::memory_order_relaxed);
+
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+      // e.g., "VmRSS:      5128 kB"
+      if (line.compare(0, 6, "VmRSS:") == 0) {
+        usage.residentBytes = std::strtoull(line.c_str() + 6, nullptr, 10) * 1024;
+      }
+      else if (line.compare(0, 6, "VmHWM:") == 0) {
+        usage.peakResidentBytes = std::strtoull(line.c_str() + 6, nullptr, 10) * 1024;
+      }
+    }
+    return usage;
+  }
+
+  /**
+   * \brief Allocations that have not been freed yet.
+   */
+  uint64_t
+  getLiveAllocations() const
+  {
+    return nAllocations - nDeallocations;
+  }
+
+  /**
+   * \brief Formats the snapshot for a progress line.
+   */
+  std::string
+  toString() const
+  {
+    return "RSS=" + formatMebibytes(residentBytes) + ", PeakRSS=" + formatMebibytes(peakResidentBytes) +
+           ", Allocations=" + std::to_string(nAllocations) +
+           ", LiveAllocations=" + std::to_string(getLiveAllocations());
+  }
+
+  static std::string
+  formatMebibytes(uint64_t bytes)
+  {
+    char str[32];
+    std::snprintf(str, sizeof(str), "%.1fMiB", bytes / 1048576.0);
+    return str;
+  }
+
+  uint64_t residentBytes = 0;
+  uint64_t peakResidentBytes = 0;
+  uint64_t nAllocations = 0;
+  uint64_t nDeallocations = 0;
+};
+
+inline void
+logMemoryUsage(Logger& logger, const MemoryUsage& usage)
+{
+  using std::to_string;
+
+  logger.log("Resident Memory             = " + MemoryUsage::formatMebibytes(usage.residentBytes), false, true);
+  logger.log("Peak Resident Memory        = " + MemoryUsage::formatMebibytes(usage.peakResidentBytes),
+             false, true);
+  logger.log("Heap Allocations            = " + to_string(usage.nAllocations), false, true);
+  logger.log("Live Heap Allocations       = " + to_string(usage.getLiveAllocations()) + "\n", false, true);
+}
+
+inline void
+writeMemoryMetrics(MetricsWriter& writer, const std::string& prefix, const MemoryUsage& usage)
+{
+  writer.writeHeader(prefix + "resident_memory_bytes", "gauge", "Resident set size of the process");
+  writer.writeSample(prefix + "resident_memory_bytes", "", usage.residentBytes);
+  writer.writeHeader(prefix + "peak_resident_memory_bytes", "gauge", "Peak resident set size of the process");
+  writer.writeSample(prefix + "peak_resident_memory_bytes", "", usage.peakResidentBytes);
+  writer.writeHeader(prefix + "heap_allocations_total", "counter", "Heap allocations made with operator new");
+  writer.writeSample(prefix + "heap_allocations_total", "", usage.nAllocations);
+  writer.writeHeader(prefix + "live_heap_allocations", "gauge", "Heap allocations that were not freed yet");
+  writer.writeSample(prefix + "live_heap_allocations", "", usage.getLiveAllocations());
+}
+
+} // namespace ndntg
+
+// replaceable allocation functions, see MemoryUsage; the nothrow and array forms call these
+
+void*
+operator new(std::size_t size)
+{
+  return ndntg::detail::countedAllocate(size);
+}
+
+void*
+operator new(std::size_t size, std::align_val_t alignment)
+{
+  return ndntg::detail::countedAllocate(size, alignment);
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  ndntg::detail::countedFree(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept
+{
+  ndntg::detail::countedFree(ptr);
+}
+
+void
+operator delete(void* ptr, std::align_val_t) noexcept
+{
+  ndntg::detail::countedFree(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+  ndntg::detail::countedFree(ptr);
+}
+
+#endif // NDNTG_MEMORY_USAGE_HPP
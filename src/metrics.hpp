@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_METRICS_HPP
+#define NDNTG_METRICS_HPP
+
+#include "histogram.hpp"
+#include "local-socket-server.hpp"
+
+#include <array>
+#include <sstream>
+#include <utility>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+namespace ndntg {
+
+/**
+ * \brief Formats metrics in the Prometheus text exposition format.
+ */
+class MetricsWriter
+{
+public:
+  MetricsWriter()
+  {
+    m_os.precision(12);
+  }
+
+  /**
+   * \brief Starts a metric family; must precede the samples of that family.
+   * \param type one of "counter", "gauge", "histogram"
+   */
+  void
+  writeHeader(std::string_view name, std::string_view type, std::string_view help)
+  {
+    m_os << "# HELP " << name << ' ' << help << '\n'
+         << "# TYPE " << name << ' ' << type << '\n';
+  }
+
+  template<typename T>
+  void
+  writeSample(std::string_view name, std::string_view labels, T value)
+  {
+    m_os << name;
+    if (!labels.empty()) {
+      m_os << '{' << labels << '}';
+    }
+    m_os << ' ' << value << '\n';
+  }
+
+  /**
+   * \brief Writes the samples of a histogram, with values expressed in seconds.
+   */
+  void
+  writeHistogram(std::string_view name, std::string_view labels, const Histogram& histogram)
+  {
+    std::string bucketName(name);
+    bucketName += "_bucket";
+    std::string prefix(labels);
+    if (!prefix.empty()) {
+      prefix += ',';
+    }
+
+    for (const auto& [le, bound] : BUCKET_BOUNDS) {
+      writeSample(bucketName, prefix + "le=\"" + le + '"', histogram.getCountAtOrBelow(bound));
+    }
+    writeSample(bucketName, prefix + "le=\"+Inf\"", histogram.getCount());
+    writeSample(std::string(name) + "_sum", labels,
+                std::chrono::duration<double>(histogram.getSum()).count());
+    writeSample(std::string(name) + "_count", labels, histogram.getCount());
+  }
+
+  static std::string
+  makeLabel(std::string_view key, std::size_t value)
+  {
+    return std::string(key) + "=\"" + std::to_string(value) + '"';
+  }
+
+  std::string
+  str() const
+  {
+    return m_os.str();
+  }
+
+private:
+  static inline const std::array<std::pair<const char*, std::chrono::nanoseconds>, 17> BUCKET_BOUNDS{{
+    {"0.00005", std::chrono::microseconds(50)},
+    {"0.0001", std::chrono::microseconds(100)},
+    {"0.00025", std::chrono::microseconds(250)},
+    {"0.0005", std::chrono::microseconds(500)},
+    {"0.001", std::chrono::milliseconds(1)},
+    {"0.0025", std::chrono::microseconds(2500)},
+    {"0.005", std::chrono::milliseconds(5)},
+    {"0.01", std::chrono::milliseconds(10)},
+    {"0.025", std::chrono::milliseconds(25)},
+    {"0.05", std::chrono::milliseconds(50)},
+    {"0.1", std::chrono::milliseconds(100)},
+    {"0.25", std::chrono::milliseconds(250)},
+    {"0.5", std::chrono::milliseconds(500)},
+    {"1", std::chrono::seconds(1)},
+    {"2.5", std::chrono::milliseconds(2500)},
+    {"5", std::chrono::seconds(5)},
+    {"10", std::chrono::seconds(10)},
+  }};
+
+  std::ostringstream m_os;
+};
+
+/**
+ * \brief Serves a snapshot of the metrics to every client that connects to a Unix socket.
+ *
+ * The snapshot is taken on the io_context thread when a scrape arrives, so the packet
+ * processing path never needs to synchronize with the exporter. Both a plain connection
+ * (e.g., `socat - UNIX-CONNECT:<path>`) and an HTTP GET request (e.g., `curl --unix-socket`)
+ * are supported.
+ */
+class MetricsExporter
+{
+public:
+  using Collector = std::function<void(MetricsWriter&)>;
+
+  MetricsExporter(boost::asio::io_context& io, std::string path, Collector collector)
+    : m_server(io, std::move(path), [this] (auto&&... args) { return respond(args...); }, true)
+    , m_collector(std::move(collector))
+  {
+  }
+
+  /**
+   * \throw boost::system::system_error the socket cannot be created
+   */
+  void
+  start()
+  {
+    m_server.start();
+  }
+
+  void
+  stop()
+  {
+    m_server.stop();
+  }
+
+private:
+  std::string
+  respond(std::string_view request, bool)
+  {
+    MetricsWriter writer;
+    m_collector(writer);
+    auto body = writer.str();
+
+    if (!boost::starts_with(request, "GET ")) {
+      return body;
+    }
+    return "HTTP/1.0 200 OK\r\n"
+           "Content-Type: text/plain; version=0.0.4\r\n"
+           "Content-Length: " + std::to_string(body.size()) + "\r\n"
+           "Connection: close\r\n"
+           "\r\n" + body;
+  }
+
+private:
+  LocalSocketServer m_server;
+  const Collector m_collector;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_METRICS_HPP
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_NAME_ENCODER_HPP
+#define NDNTG_NAME_ENCODER_HPP
+
+#include "random.hpp"
+
+#include <ndn-cxx/name.hpp>
+
+#include <algorithm>
+#include <memory>
+
+namespace ndntg {
+
+/**
+ * \brief Builds names made of a prefix, optionally a component of random bytes, and optionally
+ *        one more component, directly in their TLV encoding.
+ *
+ * Appending to an ndn::Name copies the prefix into a new name, and the components are encoded
+ * again when the Interest is. Here, the encoded prefix is copied into a buffer of the final
+ * size with one memcpy, the random bytes are written in place, and the name refers to that buffer,
+ * so it is not encoded again.
+ */
+class NameEncoder
+{
+public:
+  NameEncoder() = default;
+
+  explicit
+  NameEncoder(const ndn::Name& prefix)
+  {
+    auto value = prefix.wireEncode().value_bytes();
+    m_prefix.assign(value.begin(), value.end());
+  }
+
+  /**
+   * \param nRandomBytes length of the random component, which is omitted if zero
+   * \param suffix component appended after the random one, if not null
+   */
+  ndn::Name
+  encode(std::size_t nRandomBytes, const ndn::name::Component* suffix = nullptr) const
+  {
+    return encode(m_prefix, nRandomBytes, suffix);
+  }
+
+  /**
+   * \param prefix the TLV-VALUE of the encoded prefix, i.e., its encoded components
+   */
+  static ndn::Name
+  encode(ndn::span<const uint8_t> prefix, std::size_t nRandomBytes, const ndn::name::Component* suffix)
+  {
+    auto valueSize = prefix.size();
+    if (nRandomBytes > 0) {
+      valueSize += sizeOfVarNumber(ndn::tlv::GenericNameComponent) + sizeOfVarNumber(nRandomBytes) + nRandomBytes;
+    }
+    if (suffix != nullptr) {
+      valueSize += suffix->size();
+    }
+
+    auto buffer = std::make_shared<ndn::Buffer>(sizeOfVarNumber(ndn::tlv::Name) + sizeOfVarNumber(valueSize) +
+                                                valueSize);
+    auto* pos = writeVarNumber(buffer->data(), ndn::tlv::Name);
+    pos = writeVarNumber(pos, valueSize);
+    pos = std::copy(prefix.begin(), prefix.end(), pos);
+    if (nRandomBytes > 0) {
+      pos = writeVarNumber(pos, ndn::tlv::GenericNameComponent);
+      pos = writeVarNumber(pos, nRandomBytes);
+      random::fillBytes(pos, nRandomBytes);
+      pos += nRandomBytes;
+    }
+    if (suffix != nullptr) {
+      std::copy(suffix->data(), suffix->data() + suffix->size(), pos);
+    }
+    return ndn::Name(ndn::Block(std::move(buffer)));
+  }
+
+private:
+  static constexpr std::size_t
+  sizeOfVarNumber(uint64_t number)
+  {
+    return number < 253 ? 1 : number <= 0xffff ? 3 : number <= 0xffffffff ? 5 : 9;
+  }
+
+  /**
+   * \brief Writes \p number as a TLV VAR-NUMBER at \p pos.
+   * \return the position after the written bytes
+   */
+  static uint8_t*
+  writeVarNumber(uint8_t* pos, uint64_t number)
+  {
+    auto size = sizeOfVarNumber(number);
+    if (size == 1) {
+      *pos = static_cast<uint8_t>(number);
+      return pos + 1;
+    }
+    *pos++ = size == 3 ? 253 : size == 5 ? 254 : 255;
+    // followed by the number in network byte order
+    for (auto i = size - 1; i > 0; i--) {
+      *pos++ = static_cast<uint8_t>(number >> ((i - 1) * 8));
+    }
+    return pos;
+  }
+
+private:
+  ndn::Buffer m_prefix;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_NAME_ENCODER_HPP
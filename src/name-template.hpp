@@ -0,0 +1,319 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_NAME_TEMPLATE_HPP
+#define NDNTG_NAME_TEMPLATE_HPP
+
+#include <ndn-cxx/name.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ndntg {
+
+/**
+ * \brief A family of names described by a name URI with numeric ranges.
+ *
+ * A component may contain one range of the form {first..last}, e.g., "/site{0..999}/app"
+ * describes the 1000 names /site0/app to /site999/app. When a bound is written with leading
+ * zeros, e.g., {000..999}, values are zero-padded to the width of the longer bound. Ranges
+ * in several components multiply, and a URI without any range describes a single name.
+ *
+ * Members of the family are identified by an index between 0 and getMemberCount() - 1, and
+ * are only turned into names on demand, so the size of a family does not affect memory usage.
+ * Member 0 is made of the first value of every range.
+ */
+class NameTemplate
+{
+public:
+  NameTemplate() = default;
+
+  /**
+   * \throw std::invalid_argument \p uri is not a valid name template
+   */
+  explicit
+  NameTemplate(std::string_view uri)
+  {
+    if (uri.substr(0, 4) == "ndn:") {
+      uri.remove_prefix(4);
+    }
+
+    while (!uri.empty()) {
+      auto pos = uri.find('/');
+      auto component = uri.substr(0, pos);
+      uri.remove_prefix(pos == std::string_view::npos ? uri.size() : pos + 1);
+      if (component.empty()) {
+        continue;
+      }
+
+      try {
+        if (component.find_first_of("{}") == std::string_view::npos) {
+          m_components.append(ndn::name::Component::fromEscapedString(component));
+        }
+        else {
+          auto variable = parseVariable(component);
+          variable.stride = m_nMembers;
+          if (m_nMembers > std::numeric_limits<uint64_t>::max() / variable.getCount()) {
+            throw std::invalid_argument("too many names");
+          }
+          m_nMembers *= variable.getCount();
+          // validates the other characters of the component
+          m_components.append(ndn::name::Component::fromEscapedString(variable.format(variable.first)));
+          m_variables.push_back(std::move(variable));
+        }
+      }
+      catch (const ndn::name::Component::Error& e) {
+        throw std::invalid_argument(e.what());
+      }
+
+      if (m_variables.empty()) {
+        m_prefix = m_components;
+      }
+    }
+  }
+
+  bool
+  isTemplate() const
+  {
+    return !m_variables.empty();
+  }
+
+  /**
+   * \brief Returns the number of components of each name in the family.
+   */
+  std::size_t
+  size() const
+  {
+    return m_components.size();
+  }
+
+  /**
+   * \brief Returns the number of names in the family.
+   */
+  uint64_t
+  getMemberCount() const
+  {
+    return m_nMembers;
+  }
+
+  /**
+   * \brief Returns the leading components that are common to all names in the family.
+   */
+  const ndn::Name&
+  getPrefix() const
+  {
+    return m_prefix;
+  }
+
+  /**
+   * \pre member < getMemberCount()
+   */
+  ndn::Name
+  getName(uint64_t member) const
+  {
+    if (m_variables.empty()) {
+      return m_components;
+    }
+
+    ndn::Name name(m_prefix);
+    auto variable = m_variables.begin();
+    for (std::size_t i = m_prefix.size(); i < m_components.size(); i++) {
+      if (variable != m_variables.end() && variable->position == i) {
+        auto value = variable->first + member / variable->stride % variable->getCount();
+        name.append(ndn::name::Component::fromEscapedString(variable->format(value)));
+        ++variable;
+      }
+      else {
+        name.append(m_components[i]);
+      }
+    }
+    return name;
+  }
+
+  /**
+   * \brief Finds the member of the family that is a prefix of \p name.
+   * \return the member index, or nullopt if no name of the family is a prefix of \p name
+   */
+  std::optional<uint64_t>
+  match(const ndn::Name& name) const
+  {
+    if (name.size() < m_components.size()) {
+      return std::nullopt;
+    }
+
+    uint64_t member = 0;
+    auto variable = m_variables.begin();
+    for (std::size_t i = 0; i < m_components.size(); i++) {
+      if (variable != m_variables.end() && variable->position == i) {
+        auto value = variable->parse(name[i].toUri());
+        if (!value) {
+          return std::nullopt;
+        }
+        member += (*value - variable->first) * variable->stride;
+        ++variable;
+      }
+      else if (name[i] != m_components[i]) {
+        return std::nullopt;
+      }
+    }
+    return member;
+  }
+
+  /**
+   * \brief Returns the template in canonical URI form.
+   */
+  std::string
+  toUri() const
+  {
+    if (m_components.empty()) {
+      return "/";
+    }
+
+    std::string uri;
+    auto variable = m_variables.begin();
+    for (std::size_t i = 0; i < m_components.size(); i++) {
+      uri += '/';
+      if (variable != m_variables.end() && variable->position == i) {
+        uri += variable->head + '{' + variable->pad(variable->first) + ".." +
+               variable->pad(variable->last) + '}' + variable->tail;
+        ++variable;
+      }
+      else {
+        uri += m_components[i].toUri();
+      }
+    }
+    return uri;
+  }
+
+private:
+  /**
+   * \brief A component of the form head{first..last}tail.
+   */
+  struct Variable
+  {
+    uint64_t
+    getCount() const
+    {
+      return last - first + 1;
+    }
+
+    std::string
+    pad(uint64_t value) const
+    {
+      auto digits = std::to_string(value);
+      if (digits.size() < width) {
+        digits.insert(0, width - digits.size(), '0');
+      }
+      return digits;
+    }
+
+    std::string
+    format(uint64_t value) const
+    {
+      return head + pad(value) + tail;
+    }
+
+    /**
+     * \brief Extracts the value from the URI representation of a component.
+     */
+    std::optional<uint64_t>
+    parse(std::string_view uri) const
+    {
+      if (uri.size() <= head.size() + tail.size() ||
+          uri.substr(0, head.size()) != head || uri.substr(uri.size() - tail.size()) != tail) {
+        return std::nullopt;
+      }
+      auto digits = uri.substr(head.size(), uri.size() - head.size() - tail.size());
+      if (width > 0 ? digits.size() != width : digits.size() > 1 && digits[0] == '0') {
+        return std::nullopt;
+      }
+
+      uint64_t value = 0;
+      auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+      if (ec != std::errc() || end != digits.data() + digits.size() || value < first || value > last) {
+        return std::nullopt;
+      }
+      return value;
+    }
+
+    std::size_t position = 0;
+    std::string head;
+    std::string tail;
+    uint64_t first = 0;
+    uint64_t last = 0;
+    std::size_t width = 0;
+    uint64_t stride = 1;
+  };
+
+  Variable
+  parseVariable(std::string_view component) const
+  {
+    auto open = component.find('{');
+    auto close = component.find('}');
+    if (open == std::string_view::npos || close == std::string_view::npos || close < open ||
+        component.find_first_of("{}", close + 1) != std::string_view::npos ||
+        component.find('{', open + 1) < close) {
+      throw std::invalid_argument("a component may contain a single {first..last} range");
+    }
+
+    auto range = component.substr(open + 1, close - open - 1);
+    auto dots = range.find("..");
+    if (dots == std::string_view::npos) {
+      throw std::invalid_argument("malformed range {" + std::string(range) + "}");
+    }
+    auto firstDigits = range.substr(0, dots);
+    auto lastDigits = range.substr(dots + 2);
+
+    Variable variable;
+    variable.position = m_components.size();
+    variable.head = component.substr(0, open);
+    variable.tail = component.substr(close + 1);
+    auto parseBound = [&] (std::string_view digits, uint64_t& value) {
+      auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+      if (digits.empty() || ec != std::errc() || end != digits.data() + digits.size()) {
+        throw std::invalid_argument("malformed range {" + std::string(range) + "}");
+      }
+    };
+    parseBound(firstDigits, variable.first);
+    parseBound(lastDigits, variable.last);
+    if (variable.first > variable.last ||
+        variable.last - variable.first == std::numeric_limits<uint64_t>::max()) {
+      throw std::invalid_argument("empty or unbounded range {" + std::string(range) + "}");
+    }
+    if ((firstDigits.size() > 1 && firstDigits[0] == '0') || (lastDigits.size() > 1 && lastDigits[0] == '0')) {
+      variable.width = std::max(firstDigits.size(), lastDigits.size());
+    }
+    return variable;
+  }
+
+private:
+  ndn::Name m_components; ///< all components, holding the first value of each range
+  ndn::Name m_prefix;     ///< components before the first range
+  std::vector<Variable> m_variables;
+  uint64_t m_nMembers = 1;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_NAME_TEMPLATE_HPP
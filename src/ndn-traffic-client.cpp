@@ -18,7 +18,23 @@
  * Author: Jerald Paul Abraham <jeraldabraham@email.arizona.edu>
  */
 
+#include "batching-transport.hpp"
+#include "execution-mode.hpp"
+#include "coordination.hpp"
+#include "data-validator.hpp"
+#include "load-schedule.hpp"
+#include "memory-usage.hpp"
+#include "metrics.hpp"
+#include "name-encoder.hpp"
+#include "name-template.hpp"
+#include "pattern-statistics.hpp"
+#include "random.hpp"
+#include "raw-face.hpp"
+#include "run-periods.hpp"
+#include "timestamp-source.hpp"
+#include "trace.hpp"
 #include "util.hpp"
+#include "zipf-distribution.hpp"
 
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/face.hpp>
@@ -31,9 +47,12 @@
 #include <limits>
 #include <optional>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/host_name.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/signal_set.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/core/noncopyable.hpp>
@@ -42,6 +61,8 @@
 #include <boost/program_options/parsers.hpp>
 #include <boost/program_options/variables_map.hpp>
 
+#include <unistd.h>
+
 using namespace std::chrono_literals;
 
 namespace ndntg {
@@ -66,9 +87,40 @@ public:
   }
 
   void
-  setInterestInterval(std::chrono::milliseconds interval)
+  setMaximumOutstanding(uint64_t maxOutstanding)
+  {
+    BOOST_ASSERT(maxOutstanding > 0);
+    m_nMaximumOutstanding = maxOutstanding;
+  }
+
+  void
+  setReportInterval(std::chrono::milliseconds interval)
   {
     BOOST_ASSERT(interval > 0ms);
+    m_reportInterval = interval;
+  }
+
+  void
+  setRunPeriods(const RunPeriods& periods)
+  {
+    m_runPeriods = periods;
+  }
+
+  /**
+   * \brief Waits at most \p period for the outstanding Interests once generation has finished,
+   *        instead of the longest InterestLifetime in use.
+   */
+  void
+  setDrainPeriod(std::chrono::milliseconds period)
+  {
+    BOOST_ASSERT(period >= 0ms);
+    m_drainPeriod = period;
+  }
+
+  void
+  setInterestInterval(std::chrono::nanoseconds interval)
+  {
+    BOOST_ASSERT(interval > 0ns);
     m_interestInterval = interval;
   }
 
@@ -90,17 +142,158 @@ public:
     m_wantVerbose = true;
   }
 
+  void
+  setMetricsSocket(std::string path)
+  {
+    m_metricsSocket = std::move(path);
+  }
+
+  void
+  setControlSocket(std::string path)
+  {
+    m_controlSocket = std::move(path);
+  }
+
+  void
+  setLoadSchedule(std::string scheduleFile)
+  {
+    m_scheduleFile = std::move(scheduleFile);
+  }
+
+  void
+  setLagThreshold(std::chrono::nanoseconds threshold)
+  {
+    m_lagThreshold = threshold;
+  }
+
+  void
+  setBatchedWrites()
+  {
+    m_wantBatchedWrites = true;
+  }
+
+  void
+  setRawEngine()
+  {
+    m_wantRawEngine = true;
+  }
+
+  void
+  setExecutionMode(ExecutionMode mode)
+  {
+    m_executionMode = std::move(mode);
+  }
+
+  void
+  setClock(TimestampSource::Type type)
+  {
+    m_clockType = type;
+  }
+
+  void
+  setCoarseTimestamps()
+  {
+    m_logger.setCoarseTimestamps();
+  }
+
+  void
+  setCoordinator(std::string endpoint)
+  {
+    m_coordinatorEndpoint = std::move(endpoint);
+  }
+
+  void
+  setValidatorConfig(std::string configFile)
+  {
+    m_validatorConfigFile = std::move(configFile);
+  }
+
+  void
+  setTrace(std::string traceFile, double speed)
+  {
+    BOOST_ASSERT(speed > 0.0);
+    m_traceFile = std::move(traceFile);
+    m_traceSpeed = speed;
+  }
+
   int
   run()
   {
     m_logger.initialize(std::to_string(ndn::random::generateWord32()), m_timestampFormat);
 
-    if (!readConfigurationFile(m_configurationFile, m_trafficPatterns, m_logger)) {
+    // before anything is allocated for the traffic, so that it lands on the right NUMA node
+    try {
+      m_executionMode.apply();
+    }
+    catch (const std::system_error& e) {
+      m_logger.log("ERROR: Unable to set execution mode: "s + e.what(), false, true);
+      return 2;
+    }
+    // after pinning, so that the clock is calibrated on the CPU that reads it
+    if (!m_clock.setType(m_clockType)) {
+      m_logger.log("WARNING: The TSC is not invariant or not available, using the monotonic clock", false, true);
+    }
+
+    if (m_wantRawEngine) {
+      m_rawFace.emplace(m_io);
+      m_batchingTransport = m_rawFace->getTransport();
+    }
+    else {
+      if (m_wantBatchedWrites) {
+        m_batchingTransport = BatchingTransport::create();
+      }
+      m_face.emplace(m_batchingTransport, m_io);
+    }
+
+    if (!m_configurationFile.empty() &&
+        !readConfigurationFile(m_configurationFile, m_trafficPatterns, m_logger)) {
+      return 2;
+    }
+
+    if (!m_traceFile.empty()) {
+      try {
+        m_traceReader.emplace(m_traceFile);
+        m_nextTraceRecord = m_traceReader->next();
+      }
+      catch (const std::exception& e) {
+        m_logger.log("ERROR: Unable to read trace file: "s + e.what(), false, true);
+        return 2;
+      }
+
+      // trace records are accounted to the pattern with the longest matching Name,
+      // records that match none of them fall into a catch-all pattern
+      if (std::none_of(m_trafficPatterns.begin(), m_trafficPatterns.end(),
+                       [] (const auto& pattern) { return pattern.m_nameTemplate.size() == 0; })) {
+        m_trafficPatterns.emplace_back().m_name = "/";
+      }
+    }
+    else if (m_trafficPatterns.empty()) {
+      m_logger.log("ERROR: No traffic pattern in configuration file: " + m_configurationFile, false, true);
       return 2;
     }
 
     if (!checkTrafficPatternCorrectness()) {
-      m_logger.log("ERROR: Traffic configuration provided is not proper", false, true);
+      m_logger.log("ERROR: Sum of TrafficPercentage of all patterns exceeds 100", false, true);
+      return 2;
+    }
+    m_patternSelector = PatternSelector(m_trafficPatterns);
+    m_patternStatistics.resize(m_trafficPatterns.size());
+    m_warmupStatistics.resize(m_trafficPatterns.size());
+    m_cooldownStatistics.resize(m_trafficPatterns.size());
+    m_nPatternInterestsSent.resize(m_trafficPatterns.size());
+
+    if (!m_validatorConfigFile.empty()) {
+      try {
+        m_dataValidator.load(m_validatorConfigFile, m_face ? &*m_face : nullptr);
+      }
+      catch (const std::exception& e) {
+        m_logger.log("ERROR: Unable to load validator configuration: "s + e.what(), false, true);
+        return 2;
+      }
+    }
+    else if (std::any_of(m_trafficPatterns.begin(), m_trafficPatterns.end(),
+                         [] (const auto& pattern) { return pattern.m_validation == DataValidator::Method::ANCHOR; })) {
+      m_logger.log("ERROR: Validation=anchor requires a validator configuration (--validator-config)", false, true);
       return 2;
     }
 
@@ -111,18 +304,80 @@ public:
       m_logger.log("", false, false);
     }
 
+    if (!m_scheduleFile.empty()) {
+      m_schedule.emplace();
+      if (!m_schedule->load(m_scheduleFile, m_logger)) {
+        return 2;
+      }
+      const auto& phases = m_schedule->getPhases();
+      for (std::size_t i = 0; i < phases.size(); i++) {
+        m_logger.log("Load Schedule Phase #" + std::to_string(i + 1), false, false);
+        phases[i].printTrafficConfiguration(m_logger);
+        m_logger.log("", false, false);
+      }
+      m_phaseStatistics.resize(phases.size());
+    }
+
     if (m_nMaximumInterests == 0) {
       logStatistics();
       return 0;
     }
 
-    m_signalSet.async_wait([this] (auto&&...) { stop(); });
+    waitForSignal();
+
+    if (!m_metricsSocket.empty()) {
+      try {
+        m_metricsExporter.emplace(m_io, m_metricsSocket, [this] (auto& writer) { writeMetrics(writer); });
+        m_metricsExporter->start();
+      }
+      catch (const boost::system::system_error& e) {
+        m_logger.log("ERROR: Unable to create metrics socket " + m_metricsSocket + ": " + e.what(),
+                     false, true);
+        return 2;
+      }
+    }
+
+    if (!m_controlSocket.empty()) {
+      try {
+        m_controlServer.emplace(m_io, m_controlSocket,
+                                [this] (auto request, bool) { return processControlCommand(request); },
+                                false);
+        m_controlServer->start();
+      }
+      catch (const boost::system::system_error& e) {
+        m_logger.log("ERROR: Unable to create control socket " + m_controlSocket + ": " + e.what(),
+                     false, true);
+        return 2;
+      }
+    }
+
+    if (m_reportInterval) {
+      m_reportTimer.expires_after(*m_reportInterval);
+      scheduleProgressReport();
+    }
 
-    boost::asio::steady_timer timer(m_io, m_interestInterval);
-    timer.async_wait([this, &timer] (auto&&...) { generateTraffic(timer); });
+    if (!m_coordinatorEndpoint.empty()) {
+      if (!joinCoordinatedRun()) {
+        return 2;
+      }
+    }
+    else {
+      startTrafficGeneration();
+    }
 
     try {
-      m_face.processEvents();
+      if (m_rawFace) {
+        m_rawFace->processEvents(m_executionMode.wantBusyPoll);
+      }
+      else if (m_executionMode.wantBusyPoll) {
+        // a negative timeout polls once without blocking
+        while (!m_io.stopped()) {
+          m_face->processEvents(ndn::time::milliseconds(-1));
+        }
+      }
+      else {
+        m_face->processEvents();
+      }
       return m_hasError ? 1 : 0;
     }
     catch (const std::exception& e) {
@@ -133,6 +388,67 @@ public:
   }
 
 private:
+  /**
+   * \brief Bounded window of the names that were most recently satisfied for a traffic pattern.
+   *
+   * Names are kept in their TLV encoding, each in a slot that is overwritten in place when the
+   * window wraps around, so that a full window neither allocates memory nor keeps the received
+   * Data alive.
+   */
+  class RecentNames
+  {
+  public:
+    void
+    setCapacity(std::size_t capacity)
+    {
+      BOOST_ASSERT(capacity > 0);
+      m_capacity = capacity;
+      m_slots.clear();
+      m_next = 0;
+    }
+
+    std::size_t
+    getCapacity() const
+    {
+      return m_capacity;
+    }
+
+    bool
+    empty() const
+    {
+      return m_slots.empty();
+    }
+
+    void
+    insert(const ndn::Name& name)
+    {
+      const auto& wire = name.wireEncode();
+      if (m_slots.size() < m_capacity) {
+        m_slots.emplace_back(wire.begin(), wire.end());
+      }
+      else {
+        m_slots[m_next].assign(wire.begin(), wire.end());
+      }
+      m_next = (m_next + 1) % m_capacity;
+    }
+
+    /**
+     * \brief Picks one of the names in the window uniformly at random; the window must not be empty.
+     */
+    ndn::Name
+    select() const
+    {
+      std::uniform_int_distribution<std::size_t> dist(0, m_slots.size() - 1);
+      const auto& slot = m_slots[dist(random::getEngine())];
+      return ndn::Name(ndn::Block(ndn::make_span(slot.data(), slot.size())));
+    }
+
+  private:
+    std::size_t m_capacity = 1000;
+    std::vector<std::vector<uint8_t>> m_slots;
+    std::size_t m_next = 0;
+  };
+
   class InterestTrafficConfiguration
   {
   public:
@@ -143,6 +459,12 @@ private:
 
       os << "TrafficPercentage=" << m_trafficPercentage << ", ";
       os << "Name=" << m_name << ", ";
+      if (m_nameTemplate.isTemplate()) {
+        os << "NameCount=" << m_nameTemplate.getMemberCount() << ", ";
+        if (m_nameDistribution) {
+          os << "NameDistribution=zipf:" << m_nameDistribution->getExponent() << ", ";
+        }
+      }
       if (m_nameAppendBytes) {
         os << "NameAppendBytes=" << *m_nameAppendBytes << ", ";
       }
@@ -167,6 +489,20 @@ private:
       if (m_expectedContent) {
         os << "ExpectedContent=" << *m_expectedContent << ", ";
       }
+      if (m_validation != DataValidator::Method::NONE) {
+        os << "Validation=" << DataValidator::toString(m_validation) << ", ";
+      }
+      if (m_burstSize > 1) {
+        os << "BurstSize=" << m_burstSize << ", ";
+      }
+      if (m_sustainOutstanding > 0) {
+        os << "SustainOutstanding=" << m_sustainOutstanding << ", ";
+      }
+      if (m_rerequestPercentage > 0.0) {
+        os << "RerequestPercentage=" << m_rerequestPercentage << ", ";
+        os << "RerequestWindow=" << m_recentNames.getCapacity() << ", ";
+        os << "RerequestMustBeFresh=" << m_rerequestMustBeFresh << ", ";
+      }
 
       auto str = os.str();
       str = str.substr(0, str.length() - 2); // remove suffix ", "
@@ -174,66 +510,194 @@ private:
     }
 
     bool
-    parseConfigurationLine(const std::string& line, Logger& logger, int lineNumber)
+    parseConfigurationLine(std::string_view parameter, std::string_view value, Logger& logger, int lineNumber)
     {
-      std::string parameter, value;
-      if (!extractParameterAndValue(line, parameter, value)) {
-        logger.log("Line " + std::to_string(lineNumber) + " - Invalid syntax: " + line,
-                   false, true);
-        return false;
-      }
+      auto fail = [&] (const std::string& message) {
+        return reportConfigurationError(logger, lineNumber, message);
+      };
+      auto parseInteger = [&] (auto& result, uint64_t maxValue) {
+        uint64_t number = 0;
+        if (!parseNumber(value, number) || number > maxValue) {
+          return fail(std::string(parameter) + " must be an integer between 0 and " + std::to_string(maxValue));
+        }
+        result = static_cast<std::remove_reference_t<decltype(result)>>(number);
+        return true;
+      };
+      auto parseFlag = [&] (bool& result) {
+        auto flag = parseBoolean(value);
+        if (!flag) {
+          return fail(std::string(parameter) + " must be a boolean value");
+        }
+        result = *flag;
+        return true;
+      };
 
       if (parameter == "TrafficPercentage") {
-        m_trafficPercentage = std::stod(value);
-        if (!std::isfinite(m_trafficPercentage)) {
-          logger.log("Line " + std::to_string(lineNumber) +
-                     " - TrafficPercentage must be a finite floating point value", false, true);
-          return false;
+        if (!parseNumber(value, m_trafficPercentage) || m_trafficPercentage < 0.0 || m_trafficPercentage > 100.0) {
+          return fail("TrafficPercentage must be a number between 0 and 100");
         }
       }
       else if (parameter == "Name") {
+        try {
+          m_nameTemplate = NameTemplate(value);
+        }
+        catch (const std::exception& e) {
+          return fail("Invalid Name: "s + e.what());
+        }
         m_name = value;
+        // without a range, the prefix is the whole name
+        m_nameEncoder = NameEncoder(m_nameTemplate.getPrefix());
+        updateNameDistribution();
+      }
+      else if (parameter == "NameDistribution") {
+        double exponent = 0.0;
+        if (value == "uniform") {
+          m_zipfExponent.reset();
+        }
+        else if (value.substr(0, 5) == "zipf:" && parseNumber(value.substr(5), exponent) && exponent > 0.0) {
+          m_zipfExponent = exponent;
+        }
+        else {
+          return fail("NameDistribution must be 'uniform' or 'zipf:<exponent>' with a positive exponent");
+        }
+        updateNameDistribution();
       }
       else if (parameter == "NameAppendBytes") {
-        m_nameAppendBytes = std::stoul(value);
+        std::size_t nBytes = 0;
+        if (!parseInteger(nBytes, ndn::MAX_NDN_PACKET_SIZE)) {
+          return false;
+        }
+        m_nameAppendBytes = nBytes;
       }
       else if (parameter == "NameAppendSequenceNumber") {
-        m_nameAppendSeqNum = std::stoull(value);
+        uint64_t seqNum = 0;
+        if (!parseInteger(seqNum, std::numeric_limits<uint64_t>::max())) {
+          return false;
+        }
+        m_nameAppendSeqNum = seqNum;
       }
       else if (parameter == "CanBePrefix") {
-        m_canBePrefix = parseBoolean(value);
+        return parseFlag(m_canBePrefix);
       }
       else if (parameter == "MustBeFresh") {
-        m_mustBeFresh = parseBoolean(value);
+        return parseFlag(m_mustBeFresh);
       }
       else if (parameter == "NonceDuplicationPercentage") {
-        m_nonceDuplicationPercentage = std::stoul(value);
+        return parseInteger(m_nonceDuplicationPercentage, 100);
       }
       else if (parameter == "InterestLifetime") {
-        m_interestLifetime = time::milliseconds(std::stoul(value));
+        uint64_t lifetime = 0;
+        if (!parseInteger(lifetime, std::numeric_limits<uint32_t>::max())) {
+          return false;
+        }
+        m_interestLifetime = time::milliseconds(lifetime);
       }
       else if (parameter == "NextHopFaceId") {
-        m_nextHopFaceId = std::stoull(value);
+        return parseInteger(m_nextHopFaceId, std::numeric_limits<uint64_t>::max());
       }
       else if (parameter == "ExpectedContent") {
         m_expectedContent = value;
       }
+      else if (parameter == "BurstSize") {
+        if (!parseInteger(m_burstSize, MAX_BURST_SIZE)) {
+          return false;
+        }
+        if (m_burstSize == 0) {
+          return fail("BurstSize must be positive");
+        }
+      }
+      else if (parameter == "SustainOutstanding") {
+        return parseInteger(m_sustainOutstanding, MAX_SUSTAINED_OUTSTANDING);
+      }
+      else if (parameter == "RerequestPercentage") {
+        if (!parseNumber(value, m_rerequestPercentage) || m_rerequestPercentage < 0.0 ||
+            m_rerequestPercentage > 100.0) {
+          return fail("RerequestPercentage must be a number between 0 and 100");
+        }
+      }
+      else if (parameter == "RerequestWindow") {
+        std::size_t window = 0;
+        if (!parseInteger(window, MAX_REREQUEST_WINDOW)) {
+          return false;
+        }
+        if (window == 0) {
+          return fail("RerequestWindow must be positive");
+        }
+        m_recentNames.setCapacity(window);
+      }
+      else if (parameter == "RerequestMustBeFresh") {
+        return parseFlag(m_rerequestMustBeFresh);
+      }
+      else if (parameter == "Validation") {
+        auto method = DataValidator::parseMethod(value);
+        if (!method) {
+          return fail("Validation must be 'none', 'digest', or 'anchor'");
+        }
+        m_validation = *method;
+      }
       else {
-        logger.log("Line " + std::to_string(lineNumber) + " - Ignoring unknown parameter: " + parameter,
-                   false, true);
+        logger.log("Line " + std::to_string(lineNumber) + " - Ignoring unknown parameter: " +
+                   std::string(parameter), false, true);
       }
       return true;
     }
 
     bool
-    checkTrafficDetailCorrectness() const
+    checkTrafficDetailCorrectness(Logger& logger, int lineNumber) const
     {
+      if (m_name.empty()) {
+        return reportConfigurationError(logger, lineNumber, "Traffic pattern has no Name");
+      }
+      if (m_sustainOutstanding > 0) {
+        if (m_nameAppendBytes.value_or(0) == 0 && !m_nameAppendSeqNum) {
+          return reportConfigurationError(logger, lineNumber, "SustainOutstanding requires unique names, "
+                                          "i.e., NameAppendBytes or NameAppendSequenceNumber");
+        }
+        if (m_burstSize > 1) {
+          return reportConfigurationError(logger, lineNumber, "SustainOutstanding cannot be combined with BurstSize");
+        }
+      }
       return true;
     }
 
+    /**
+     * \brief Picks the member of the name family for the next Interest.
+     */
+    uint64_t
+    selectNameMember() const
+    {
+      if (m_nameDistribution) {
+        return (*m_nameDistribution)(random::getEngine());
+      }
+      auto nMembers = m_nameTemplate.getMemberCount();
+      if (nMembers == 1) {
+        return 0;
+      }
+      std::uniform_int_distribution<uint64_t> dist(0, nMembers - 1);
+      return dist(random::getEngine());
+    }
+
+  private:
+    void
+    updateNameDistribution()
+    {
+      if (m_zipfExponent && m_nameTemplate.isTemplate()) {
+        m_nameDistribution.emplace(m_nameTemplate.getMemberCount(), *m_zipfExponent);
+      }
+      else {
+        m_nameDistribution.reset();
+      }
+    }
+
   public:
     double m_trafficPercentage = 0.0;
     std::string m_name;
+    NameTemplate m_nameTemplate;
+    /// encoded Name of a pattern without ranges, to which the appended components are added
+    NameEncoder m_nameEncoder;
+    std::optional<double> m_zipfExponent;
+    /// popularity of the names in the family, uniform if not set
+    std::optional<ZipfDistribution> m_nameDistribution;
     std::optional<std::size_t> m_nameAppendBytes;
     std::optional<uint64_t> m_nameAppendSeqNum;
     bool m_canBePrefix = false;
@@ -242,333 +706,1790 @@ private:
     time::milliseconds m_interestLifetime = -1_ms;
     uint64_t m_nextHopFaceId = 0;
     std::optional<std::string> m_expectedContent;
+    DataValidator::Method m_validation = DataValidator::Method::NONE;
+    /// Interests sent back-to-back for each selected name, which differ only in their nonces
+    uint32_t m_burstSize = 1;
+    /// number of Interests kept outstanding regardless of the rate, zero if the rate applies
+    uint64_t m_sustainOutstanding = 0;
+    /// share of the Interests that ask again for a recently satisfied name, e.g., to hit a cache
+    double m_rerequestPercentage = 0.0;
+    bool m_rerequestMustBeFresh = false;
+    RecentNames m_recentNames;
+    bool m_isEnabled = true;
+  };
+
+  /**
+   * \brief Immutable table for picking the traffic pattern of each generated Interest.
+   *
+   * It is compiled from the enabled traffic patterns at startup and recompiled whenever a pattern
+   * is changed through the control socket, so that the selection is a binary search over the
+   * cumulative TrafficPercentage instead of a scan over all patterns.
+   */
+  class PatternSelector
+  {
+  public:
+    PatternSelector() = default;
+
+    explicit
+    PatternSelector(const std::vector<InterestTrafficConfiguration>& patterns)
+    {
+      double cumulativePercentage = 0.0;
+      for (std::size_t patternId = 0; patternId < patterns.size(); patternId++) {
+        const auto& pattern = patterns[patternId];
+        if (pattern.m_isEnabled && pattern.m_trafficPercentage > 0.0 && pattern.m_sustainOutstanding == 0) {
+          cumulativePercentage += pattern.m_trafficPercentage;
+          m_bounds.push_back(cumulativePercentage);
+          m_patternIds.push_back(patternId);
+        }
+      }
+    }
+
+    /**
+     * \brief Returns the pattern selected by \p key (0 < key <= 100), or nullopt if \p key
+     *        falls into the share of traffic that is not assigned to any pattern.
+     */
+    std::optional<std::size_t>
+    select(double key) const
+    {
+      auto it = std::lower_bound(m_bounds.begin(), m_bounds.end(), key);
+      if (it == m_bounds.end()) {
+        return std::nullopt;
+      }
+      return m_patternIds[std::distance(m_bounds.begin(), it)];
+    }
+
+  private:
+    std::vector<double> m_bounds;
+    std::vector<std::size_t> m_patternIds;
+  };
 
+  /**
+   * \brief Statistics of the Interests sent during one phase of the load schedule.
+   */
+  class PhaseStatistics
+  {
+  public:
+    std::optional<std::chrono::steady_clock::time_point> m_startTime;
     uint64_t m_nInterestsSent = 0;
     uint64_t m_nInterestsReceived = 0;
     uint64_t m_nNacks = 0;
-    uint64_t m_nContentInconsistencies = 0;
+    uint64_t m_nTimeouts = 0;
+    Histogram m_rttHistogram;
+    Histogram m_responseTimeHistogram;
+  };
+
+  /**
+   * \brief Bookkeeping attached to an Interest until its Data, Nack, or timeout is received.
+   *
+   * The service time (RTT) of an Interest is measured from \p sentTime, while its response time
+   * is measured from \p intendedTime, i.e., when the rate schedule or the trace called for it.
+   * The two differ whenever the generator falls behind, and only the latter reflects the delay
+   * that a client issuing requests at the configured rate would have experienced.
+   */
+  struct InterestContext
+  {
+    int globalRef;
+    int localRef;
+    std::size_t patternId;
+    std::optional<std::size_t> phaseId;
+    std::chrono::steady_clock::time_point intendedTime;
+    std::chrono::steady_clock::time_point sentTime;
+    bool isRerequest;
+    uint64_t burstId; ///< zero if the Interest is not part of a burst
+    RunPeriods::Period runPeriod;
+    uint32_t statisticsEpoch; ///< Interests sent before a reset of the statistics are not recorded
+  };
 
-    // RTT is stored as milliseconds with fractional sub-milliseconds precision
-    double m_minimumInterestRoundTripTime = std::numeric_limits<double>::max();
-    double m_maximumInterestRoundTripTime = 0;
-    double m_totalInterestRoundTripTime = 0;
+  /**
+   * \brief Outstanding Interests of a burst, and the last Data delivered to them.
+   */
+  struct Burst
+  {
+    uint32_t nOutstanding = 0;
+    /// holding the encoding keeps its buffer, whose address identifies the Data, from being reused
+    ndn::Block lastData;
   };
 
+  static std::string
+  formatMilliseconds(std::chrono::nanoseconds duration)
+  {
+    return std::to_string(duration.count() / 1e6) + "ms";
+  }
+
+  /**
+   * \brief Returns \p count as a percentage of the \p nCompleted Interests that were answered,
+   *        Nack'ed, or timed out.
+   *
+   * Interests that are still outstanding have no outcome yet, thus they count neither as lost
+   * nor as delivered.
+   */
+  static double
+  getOutcomePercentage(uint64_t count, uint64_t nCompleted)
+  {
+    return nCompleted > 0 ? count * 100.0 / nCompleted : 0.0;
+  }
+
+  void
+  logPhaseStatistics()
+  {
+    using std::to_string;
+
+    const auto& phases = m_schedule->getPhases();
+    auto now = std::chrono::steady_clock::now();
+    for (std::size_t phaseId = 0; phaseId < phases.size(); phaseId++) {
+      const auto& phase = phases[phaseId];
+      const auto& stats = m_phaseStatistics[phaseId];
+
+      m_logger.log("Load Schedule Phase #" + to_string(phaseId + 1), false, true);
+      phase.printTrafficConfiguration(m_logger);
+      if (!stats.m_startTime) {
+        m_logger.log("Phase not reached\n", false, true);
+        continue;
+      }
+
+      std::chrono::duration<double> elapsed = std::min<std::chrono::nanoseconds>(phase.getDuration(),
+                                                                                now - *stats.m_startTime);
+      double achievedRate = elapsed.count() > 0 ? stats.m_nInterestsSent / elapsed.count() : 0.0;
+      auto nCompleted = stats.m_nInterestsReceived + stats.m_nNacks + stats.m_nTimeouts;
+
+      m_logger.log("Target Interest Rate        = " + to_string(phase.getMeanRate()) + "/s", false, true);
+      m_logger.log("Achieved Interest Rate      = " + to_string(achievedRate) + "/s", false, true);
+      m_logger.log("Total Interests Sent        = " + to_string(stats.m_nInterestsSent), false, true);
+      m_logger.log("Total Responses Received    = " + to_string(stats.m_nInterestsReceived), false, true);
+      m_logger.log("Total Nacks Received        = " + to_string(stats.m_nNacks), false, true);
+      m_logger.log("Total Timeouts              = " + to_string(stats.m_nTimeouts), false, true);
+      m_logger.log("Interests Still Outstanding = " + to_string(stats.m_nInterestsSent - nCompleted), false, true);
+      m_logger.log("Total Interest Loss         = " +
+                   to_string(getOutcomePercentage(stats.m_nTimeouts, nCompleted)) + "%", false, true);
+      m_logger.log("Total Nack Percentage       = " +
+                   to_string(getOutcomePercentage(stats.m_nNacks, nCompleted)) + "%", false, true);
+      const auto& rtt = stats.m_rttHistogram;
+      m_logger.log("Average Round Trip Time     = " + formatMilliseconds(rtt.getMean()), false, true);
+      m_logger.log("50th Percentile RTT         = " + formatMilliseconds(rtt.getPercentile(50)), false, true);
+      m_logger.log("90th Percentile RTT         = " + formatMilliseconds(rtt.getPercentile(90)), false, true);
+      m_logger.log("99th Percentile RTT         = " + formatMilliseconds(rtt.getPercentile(99)), false, true);
+      m_logger.log("Maximum Round Trip Time     = " + formatMilliseconds(rtt.getMax()), false, true);
+      const auto& response = stats.m_responseTimeHistogram;
+      m_logger.log("99th Pct Response Time      = " + formatMilliseconds(response.getPercentile(99)), false, true);
+      m_logger.log("Maximum Response Time       = " + formatMilliseconds(response.getMax()) + "\n",
+                   false, true);
+    }
+  }
+
+  /**
+   * \param lifetime the InterestLifetime of the pattern, which the times to timeout are compared with
+   */
+  void
+  logPatternStatistics(const PatternStatistics& stats, std::optional<std::chrono::nanoseconds> lifetime = {})
+  {
+    using std::to_string;
+
+    m_logger.log("Total Interests Sent        = " + to_string(stats.m_nInterestsSent), false, true);
+    m_logger.log("Total Responses Received    = " + to_string(stats.m_nInterestsReceived), false, true);
+    m_logger.log("Total Nacks Received        = " + to_string(stats.m_nNacks), false, true);
+    m_logger.log("Total Timeouts              = " + to_string(stats.m_nTimeouts), false, true);
+    auto nCompleted = stats.getCompleted();
+    m_logger.log("Interests Still Outstanding = " + to_string(stats.m_nInterestsSent - nCompleted), false, true);
+    m_logger.log("Total Interest Loss         = " +
+                 to_string(getOutcomePercentage(stats.m_nTimeouts, nCompleted)) + "%", false, true);
+    m_logger.log("Total Nack Percentage       = " +
+                 to_string(getOutcomePercentage(stats.m_nNacks, nCompleted)) + "%", false, true);
+
+    double average = 0.0;
+    double inconsistency = 0.0;
+    if (stats.m_nInterestsReceived > 0) {
+      average = stats.m_totalInterestRoundTripTime / stats.m_nInterestsReceived;
+      inconsistency = stats.m_nContentInconsistencies * 100.0 / stats.m_nInterestsReceived;
+    }
+    m_logger.log("Total Data Inconsistency    = " + to_string(inconsistency) + "%", false, true);
+    if (stats.m_nDataValidated + stats.m_nValidationFailures > 0) {
+      logValidationStatistics(stats);
+    }
+    if (stats.m_nRerequestsSent > 0) {
+      logRerequestStatistics(stats);
+    }
+    if (stats.m_nBursts > 0 || stats.m_nDuplicateNacks > 0) {
+      m_logger.log("Total Interest Bursts Sent  = " + to_string(stats.m_nBursts), false, true);
+      m_logger.log("Shared Data Arrivals        = " + to_string(stats.m_nSharedDataArrivals), false, true);
+      m_logger.log("Total Duplicate Nacks       = " + to_string(stats.m_nDuplicateNacks), false, true);
+    }
+    m_logger.log("Total Round Trip Time       = " + to_string(stats.m_totalInterestRoundTripTime) + "ms",
+                 false, true);
+    m_logger.log("Average Round Trip Time     = " + to_string(average) + "ms", false, true);
+    logLatencyDistribution(stats.m_rttHistogram, stats.m_responseTimeHistogram);
+    if (lifetime) {
+      m_logger.log("Interest Lifetime           = " + formatMilliseconds(*lifetime), false, true);
+    }
+    m_logger.log("Median Time to Timeout      = " + formatMilliseconds(stats.m_timeoutHistogram.getPercentile(50)),
+                 false, true);
+    m_logger.log("Maximum Time to Timeout     = " + formatMilliseconds(stats.m_timeoutHistogram.getMax()) + "\n",
+                 false, true);
+  }
+
+  void
+  logValidationStatistics(const PatternStatistics& stats)
+  {
+    using std::to_string;
+
+    const auto& validationTime = stats.m_validationTimeHistogram;
+    std::chrono::duration<double> totalTime = validationTime.getSum();
+    double throughput = totalTime.count() > 0 ? validationTime.getCount() / totalTime.count() : 0.0;
+    m_logger.log("Total Data Validated        = " + to_string(stats.m_nDataValidated), false, true);
+    m_logger.log("Total Validation Failures   = " + to_string(stats.m_nValidationFailures), false, true);
+    m_logger.log("Average Validation Time     = " + formatMilliseconds(validationTime.getMean()), false, true);
+    m_logger.log("99th Pct Validation Time    = " + formatMilliseconds(validationTime.getPercentile(99)),
+                 false, true);
+    m_logger.log("Validation Throughput       = " + to_string(throughput) + "/s", false, true);
+  }
+
+  void
+  logRerequestStatistics(const PatternStatistics& stats)
+  {
+    using std::to_string;
+
+    double percentage = stats.m_nInterestsSent > 0 ? stats.m_nRerequestsSent * 100.0 / stats.m_nInterestsSent : 0.0;
+    const auto& rtt = stats.m_rerequestRttHistogram;
+    m_logger.log("Total Re-requests Sent      = " + to_string(stats.m_nRerequestsSent), false, true);
+    m_logger.log("Re-request Percentage       = " + to_string(percentage) + "%", false, true);
+    m_logger.log("Re-requests Satisfied       = " + to_string(stats.m_nRerequestsSatisfied), false, true);
+    m_logger.log("Median Re-request RTT       = " + formatMilliseconds(rtt.getPercentile(50)), false, true);
+    m_logger.log("99th Pct Re-request RTT     = " + formatMilliseconds(rtt.getPercentile(99)), false, true);
+  }
+
+  /**
+   * \brief Logs the percentiles of the service time (RTT) and of the response time.
+   */
+  void
+  logLatencyDistribution(const Histogram& serviceTime, const Histogram& responseTime)
+  {
+    m_logger.log("Median Service Time         = " + formatMilliseconds(serviceTime.getPercentile(50)),
+                 false, true);
+    m_logger.log("99th Pct Service Time       = " + formatMilliseconds(serviceTime.getPercentile(99)),
+                 false, true);
+    m_logger.log("Maximum Service Time        = " + formatMilliseconds(serviceTime.getMax()), false, true);
+    m_logger.log("Median Response Time        = " + formatMilliseconds(responseTime.getPercentile(50)),
+                 false, true);
+    m_logger.log("99th Pct Response Time      = " + formatMilliseconds(responseTime.getPercentile(99)),
+                 false, true);
+    m_logger.log("Maximum Response Time       = " + formatMilliseconds(responseTime.getMax()), false, true);
+  }
+
+  void
+  logGeneratorLag()
+  {
+    using std::to_string;
+
+    auto timeLagging = m_totalLaggingTime;
+    if (m_lagEpisodeStart) {
+      timeLagging += std::chrono::steady_clock::now() - *m_lagEpisodeStart;
+    }
+    m_logger.log("Generator Lag Threshold     = " + formatMilliseconds(m_lagThreshold), false, true);
+    m_logger.log("Average Generator Lag       = " + formatMilliseconds(m_generatorLagHistogram.getMean()),
+                 false, true);
+    m_logger.log("99th Pct Generator Lag      = " +
+                 formatMilliseconds(m_generatorLagHistogram.getPercentile(99)), false, true);
+    m_logger.log("Maximum Generator Lag       = " + formatMilliseconds(m_generatorLagHistogram.getMax()),
+                 false, true);
+    m_logger.log("Generator Lag Episodes      = " + to_string(m_nLagEpisodes), false, true);
+    m_logger.log("Time Spent Lagging          = " + formatMilliseconds(timeLagging) + "\n", false, true);
+  }
+
+  void
+  logGeneratorPauses()
+  {
+    auto timePaused = m_totalPausedTime;
+    if (m_pauseStart) {
+      timePaused += std::chrono::steady_clock::now() - *m_pauseStart;
+    }
+    m_logger.log("Outstanding Interest Limit  = " + std::to_string(*m_nMaximumOutstanding), false, true);
+    m_logger.log("Generator Pauses at Limit   = " + std::to_string(m_nPauses), false, true);
+    m_logger.log("Time Spent Paused           = " + formatMilliseconds(timePaused) + "\n", false, true);
+  }
+
+  void
+  scheduleProgressReport()
+  {
+    m_reportTimer.async_wait([this] (const boost::system::error_code& ec) {
+      if (ec) {
+        return;
+      }
+      logProgress();
+      m_reportTimer.expires_at(m_reportTimer.expiry() + *m_reportInterval);
+      scheduleProgressReport();
+    });
+  }
+
+  void
+  logProgress()
+  {
+    using std::to_string;
+
+    auto intervalSeconds = std::chrono::duration<double>(*m_reportInterval).count();
+    double rate = (m_nInterestsSent - m_nInterestsReported) / intervalSeconds;
+    m_nInterestsReported = m_nInterestsSent;
+
+    auto total = getTotalStatistics();
+    m_logger.log("Progress - Interests=" + to_string(total.m_nInterestsSent) +
+                 ", Rate=" + to_string(rate) + "/s" +
+                 ", Responses=" + to_string(total.m_nInterestsReceived) +
+                 ", Nacks=" + to_string(total.m_nNacks) +
+                 ", Timeouts=" + to_string(total.m_nTimeouts) +
+                 ", Outstanding=" + to_string(m_nOutstandingInterests), true, true);
+    m_logger.log("Memory - " + MemoryUsage::read().toString(), true, true);
+  }
+
+  void
+  logStatistics()
+  {
+    using std::to_string;
+
+    m_logger.log("\n\n== Traffic Report ==\n", false, true);
+    m_logger.log("Total Traffic Pattern Types = " + to_string(m_trafficPatterns.size()), false, true);
+    logPatternStatistics(getTotalStatistics());
+    logGeneratorLag();
+    if (m_nMaximumOutstanding) {
+      logGeneratorPauses();
+    }
+    if (m_batchingTransport) {
+      logTransportStatistics(m_logger, m_batchingTransport->getCounters());
+    }
+    m_executionMode.log(m_logger);
+    m_clock.log(m_logger);
+    logMemoryUsage(m_logger, MemoryUsage::read());
+    m_dataValidator.log(m_logger);
+    if (auto seed = random::getSeed()) {
+      m_logger.log("Random Seed                 = " + std::to_string(*seed) + "\n", false, true);
+    }
+    if (m_runPeriods.hasRamps()) {
+      m_runPeriods.log(m_logger);
+      logRampStatistics(RunPeriods::Period::WARMUP, m_warmupStatistics);
+      logRampStatistics(RunPeriods::Period::COOLDOWN, m_cooldownStatistics);
+    }
+
+    for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
+      m_logger.log("Traffic Pattern Type #" + to_string(patternId + 1), false, true);
+      m_trafficPatterns[patternId].printTrafficConfiguration(m_logger);
+      logPatternStatistics(m_patternStatistics[patternId], getInterestLifetime(m_trafficPatterns[patternId]));
+    }
+
+    if (m_schedule) {
+      logPhaseStatistics();
+    }
+    if (m_traceReader) {
+      logReplayStatistics();
+    }
+  }
+
+  /**
+   * \brief Logs the Interests sent during the warm-up or the cool-down, which are excluded from
+   *        all other statistics.
+   */
+  void
+  logRampStatistics(RunPeriods::Period period, const std::vector<PatternStatistics>& patternStatistics)
+  {
+    using std::to_string;
+
+    PatternStatistics stats;
+    for (const auto& patternStats : patternStatistics) {
+      stats.merge(patternStats);
+    }
+    auto nCompleted = stats.getCompleted();
+    const auto& rtt = stats.m_rttHistogram;
+    m_logger.log(RunPeriods::toString(period) + " Period (excluded from the statistics above)", false, true);
+    m_logger.log("Total Interests Sent        = " + to_string(stats.m_nInterestsSent), false, true);
+    m_logger.log("Total Responses Received    = " + to_string(stats.m_nInterestsReceived), false, true);
+    m_logger.log("Total Nacks Received        = " + to_string(stats.m_nNacks), false, true);
+    m_logger.log("Total Timeouts              = " + to_string(stats.m_nTimeouts), false, true);
+    m_logger.log("Interests Still Outstanding = " + to_string(stats.m_nInterestsSent - nCompleted), false, true);
+    m_logger.log("Total Interest Loss         = " +
+                 to_string(getOutcomePercentage(stats.m_nTimeouts, nCompleted)) + "%", false, true);
+    m_logger.log("50th Percentile RTT         = " + formatMilliseconds(rtt.getPercentile(50)), false, true);
+    m_logger.log("99th Percentile RTT         = " + formatMilliseconds(rtt.getPercentile(99)) + "\n",
+                 false, true);
+  }
+
+  void
+  logReplayStatistics()
+  {
+    using std::to_string;
+
+    m_logger.log("Trace File                  = " + m_traceFile, false, true);
+    m_logger.log("Trace Replay Speed          = " + to_string(m_traceSpeed) + "x", false, true);
+    m_logger.log("Trace Records Replayed      = " + to_string(m_nTraceRecordsReplayed) + "\n", false, true);
+  }
+
+  PatternStatistics
+  getTotalStatistics() const
+  {
+    PatternStatistics total;
+    for (const auto& stats : m_patternStatistics) {
+      total.merge(stats);
+    }
+    return total;
+  }
+
+  void
+  writeMetrics(MetricsWriter& writer) const
+  {
+    static const std::string prefix = "ndntg_client_";
+    auto writeCounter = [&] (const std::string& name, const std::string& help, auto member) {
+      writer.writeHeader(prefix + name, "counter", help);
+      for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
+        writer.writeSample(prefix + name, MetricsWriter::makeLabel("pattern", patternId + 1),
+                           m_patternStatistics[patternId].*member);
+      }
+    };
+
+    writeCounter("interests_sent_total", "Interests sent",
+                 &PatternStatistics::m_nInterestsSent);
+    writeCounter("data_received_total", "Data packets received",
+                 &PatternStatistics::m_nInterestsReceived);
+    writeCounter("nacks_received_total", "Nacks received",
+                 &PatternStatistics::m_nNacks);
+    writeCounter("timeouts_total", "Interests that timed out",
+                 &PatternStatistics::m_nTimeouts);
+    writeCounter("content_inconsistencies_total", "Data packets with unexpected content",
+                 &PatternStatistics::m_nContentInconsistencies);
+    writeCounter("rerequests_sent_total", "Interests sent again for a recently satisfied name",
+                 &PatternStatistics::m_nRerequestsSent);
+    writeCounter("bursts_sent_total", "Bursts of Interests for the same name",
+                 &PatternStatistics::m_nBursts);
+    writeCounter("shared_data_arrivals_total", "Data delivered to several Interests of a burst",
+                 &PatternStatistics::m_nSharedDataArrivals);
+    writeCounter("duplicate_nacks_total", "Nacks with reason Duplicate",
+                 &PatternStatistics::m_nDuplicateNacks);
+    writeCounter("data_validated_total", "Data packets with a valid signature",
+                 &PatternStatistics::m_nDataValidated);
+    writeCounter("validation_failures_total", "Data packets whose signature failed validation",
+                 &PatternStatistics::m_nValidationFailures);
+
+    writer.writeHeader(prefix + "interests_outstanding", "gauge", "Interests awaiting a response");
+    writer.writeSample(prefix + "interests_outstanding", "", m_nOutstandingInterests);
+
+    writer.writeHeader(prefix + "rtt_seconds", "histogram", "Round trip time of satisfied Interests");
+    for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
+      writer.writeHistogram(prefix + "rtt_seconds", MetricsWriter::makeLabel("pattern", patternId + 1),
+                            m_patternStatistics[patternId].m_rttHistogram);
+    }
+
+    writer.writeHeader(prefix + "response_time_seconds", "histogram",
+                       "Time from the intended transmission of Interests to the reception of their Data");
+    for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
+      writer.writeHistogram(prefix + "response_time_seconds", MetricsWriter::makeLabel("pattern", patternId + 1),
+                            m_patternStatistics[patternId].m_responseTimeHistogram);
+    }
+
+    writer.writeHeader(prefix + "time_to_timeout_seconds", "histogram",
+                       "Time from the transmission of Interests until they timed out");
+    for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
+      writer.writeHistogram(prefix + "time_to_timeout_seconds", MetricsWriter::makeLabel("pattern", patternId + 1),
+                            m_patternStatistics[patternId].m_timeoutHistogram);
+    }
+
+    writer.writeHeader(prefix + "rerequest_rtt_seconds", "histogram",
+                       "Round trip time of satisfied Interests for recently satisfied names");
+    for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
+      writer.writeHistogram(prefix + "rerequest_rtt_seconds", MetricsWriter::makeLabel("pattern", patternId + 1),
+                            m_patternStatistics[patternId].m_rerequestRttHistogram);
+    }
+
+    writer.writeHeader(prefix + "validation_seconds", "histogram",
+                       "Time from the reception of Data until their signature was validated");
+    for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
+      writer.writeHistogram(prefix + "validation_seconds", MetricsWriter::makeLabel("pattern", patternId + 1),
+                            m_patternStatistics[patternId].m_validationTimeHistogram);
+    }
+
+    writer.writeHeader(prefix + "generator_lag_seconds", "histogram",
+                       "Delay between the intended and the actual transmission of Interests");
+    writer.writeHistogram(prefix + "generator_lag_seconds", "", m_generatorLagHistogram);
+    writer.writeHeader(prefix + "generator_lag_episodes_total", "counter",
+                       "Periods during which the generator lag exceeded the threshold");
+    writer.writeSample(prefix + "generator_lag_episodes_total", "", m_nLagEpisodes);
+    writer.writeHeader(prefix + "generator_lagging", "gauge",
+                       "Whether the generator lag currently exceeds the threshold");
+    writer.writeSample(prefix + "generator_lagging", "", m_lagEpisodeStart ? 1 : 0);
+    if (m_nMaximumOutstanding) {
+      writer.writeHeader(prefix + "generator_pauses_total", "counter",
+                         "Times the generator paused because the outstanding Interest limit was reached");
+      writer.writeSample(prefix + "generator_pauses_total", "", m_nPauses);
+      writer.writeHeader(prefix + "generator_paused", "gauge",
+                         "Whether the generator is paused at the outstanding Interest limit");
+      writer.writeSample(prefix + "generator_paused", "", m_pauseStart ? 1 : 0);
+    }
+    writeMemoryMetrics(writer, prefix, MemoryUsage::read());
+
+    if (m_batchingTransport) {
+      writeTransportMetrics(writer, prefix, m_batchingTransport->getCounters());
+    }
+  }
+
+  void
+  resetStatistics()
+  {
+    for (auto& stats : m_patternStatistics) {
+      auto nOutstanding = stats.m_nOutstanding;
+      stats = {};
+      stats.m_nOutstanding = nOutstanding;
+    }
+    std::fill(m_warmupStatistics.begin(), m_warmupStatistics.end(), PatternStatistics{});
+    std::fill(m_cooldownStatistics.begin(), m_cooldownStatistics.end(), PatternStatistics{});
+    auto now = std::chrono::steady_clock::now();
+    for (auto& phase : m_phaseStatistics) {
+      auto startTime = phase.m_startTime;
+      phase = {};
+      // a phase that has begun is measured from the reset
+      if (startTime) {
+        phase.m_startTime = now;
+      }
+    }
+    // the Interests outstanding now complete without being recorded, while m_nInterestsSent,
+    // which counts towards --count and numbers the Interests, keeps running
+    m_statisticsEpoch++;
+    m_generatorLagHistogram.reset();
+    m_nLagEpisodes = 0;
+    m_totalLaggingTime = 0ns;
+    if (m_lagEpisodeStart) {
+      m_lagEpisodeStart = now;
+    }
+    m_nPauses = 0;
+    m_totalPausedTime = 0ns;
+    if (m_pauseStart) {
+      m_pauseStart = now;
+    }
+  }
+
+  /**
+   * \brief Executes one command received on the control socket.
+   *
+   * Commands run on the io_context thread between packet events, so each of them takes
+   * effect atomically with respect to Interest generation and statistics collection.
+   * Every response ends with a line that is either "OK" or starts with "ERROR:".
+   */
+  std::string
+  processControlCommand(std::string_view line)
+  {
+    std::istringstream is{std::string(line)};
+    std::string command;
+    is >> command;
+
+    if (command.empty()) {
+      return "";
+    }
+
+    if (command == "help") {
+      return "rate <Interests per second>\n"
+             "interval <milliseconds>\n"
+             "pattern <id> enable|disable\n"
+             "pattern <id> weight <TrafficPercentage>\n"
+             "reset\n"
+             "stats\n"
+             "OK\n";
+    }
+
+    if (command == "rate" || command == "interval") {
+      if (m_schedule) {
+        return "ERROR: the Interest rate is controlled by the load schedule\n";
+      }
+      if (m_traceReader) {
+        return "ERROR: the Interest rate is controlled by the trace\n";
+      }
+      double value = 0.0;
+      if (!(is >> value) || !std::isfinite(value) || value <= 0.0) {
+        return "ERROR: " + command + " must be a positive number\n";
+      }
+      double seconds = command == "rate" ? 1.0 / value : value / 1000.0;
+      if (seconds * 1e9 < 1.0 || seconds > 86400.0) {
+        return "ERROR: " + command + " is out of range\n";
+      }
+      changeInterestInterval(std::chrono::nanoseconds(static_cast<int64_t>(seconds * 1e9)));
+      return "OK\n";
+    }
+
+    if (command == "pattern") {
+      std::size_t patternNumber = 0;
+      std::string action;
+      if (!(is >> patternNumber >> action) ||
+          patternNumber < 1 || patternNumber > m_trafficPatterns.size()) {
+        return "ERROR: usage: pattern <id> enable|disable|weight <TrafficPercentage>\n";
+      }
+
+      auto& pattern = m_trafficPatterns[patternNumber - 1];
+      if (action == "enable" || action == "disable") {
+        bool wasEnabled = pattern.m_isEnabled;
+        pattern.m_isEnabled = action == "enable";
+        if (!checkTrafficPatternCorrectness()) {
+          pattern.m_isEnabled = wasEnabled;
+          return "ERROR: sum of TrafficPercentage of enabled patterns would exceed 100\n";
+        }
+        m_patternSelector = PatternSelector(m_trafficPatterns);
+        return "OK\n";
+      }
+      if (action == "weight") {
+        double percentage = 0.0;
+        if (!(is >> percentage) || !std::isfinite(percentage) || percentage < 0.0 || percentage > 100.0) {
+          return "ERROR: TrafficPercentage must be between 0 and 100\n";
+        }
+        double oldPercentage = pattern.m_trafficPercentage;
+        pattern.m_trafficPercentage = percentage;
+        if (!checkTrafficPatternCorrectness()) {
+          pattern.m_trafficPercentage = oldPercentage;
+          return "ERROR: sum of TrafficPercentage of enabled patterns would exceed 100\n";
+        }
+        m_patternSelector = PatternSelector(m_trafficPatterns);
+        return "OK\n";
+      }
+      return "ERROR: unknown pattern action '" + action + "'\n";
+    }
+
+    if (command == "reset") {
+      resetStatistics();
+      return "OK\n";
+    }
+
+    if (command == "stats") {
+      return formatStatisticsSnapshot() + "OK\n";
+    }
+
+    return "ERROR: unknown command '" + command + "', try 'help'\n";
+  }
+
+  /**
+   * \brief Returns the current statistics as one line of key=value pairs with the totals,
+   *        followed by one such line per traffic pattern.
+   */
+  std::string
+  formatStatisticsSnapshot() const
+  {
+    std::ostringstream os;
+    auto formatCounters = [&os] (const PatternStatistics& stats) {
+      os << " sent=" << stats.m_nInterestsSent << " received=" << stats.m_nInterestsReceived
+         << " nacks=" << stats.m_nNacks << " timeouts=" << stats.m_nTimeouts
+         << " rtt_avg_ms=" << stats.m_rttHistogram.getMean().count() / 1e6
+         << " rtt_p50_ms=" << stats.m_rttHistogram.getPercentile(50).count() / 1e6
+         << " rtt_p99_ms=" << stats.m_rttHistogram.getPercentile(99).count() / 1e6
+         << " response_p99_ms=" << stats.m_responseTimeHistogram.getPercentile(99).count() / 1e6 << '\n';
+    };
+
+    os << "total interval_ms=" << m_interestInterval.count() / 1e6
+       << " lag_max_ms=" << m_generatorLagHistogram.getMax().count() / 1e6
+       << " lag_episodes=" << m_nLagEpisodes
+       << " lagging=" << (m_lagEpisodeStart ? "yes" : "no");
+    formatCounters(getTotalStatistics());
+    for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
+      const auto& pattern = m_trafficPatterns[patternId];
+      os << "pattern=" << patternId + 1 << " enabled=" << (pattern.m_isEnabled ? "yes" : "no")
+         << " weight=" << pattern.m_trafficPercentage;
+      formatCounters(m_patternStatistics[patternId]);
+    }
+    return os.str();
+  }
+
+  bool
+  checkTrafficPatternCorrectness() const
+  {
+    double totalPercentage = 0.0;
+    for (const auto& pattern : m_trafficPatterns) {
+      if (pattern.m_isEnabled) {
+        totalPercentage += pattern.m_trafficPercentage;
+      }
+    }
+    return totalPercentage <= 100.0 + 1e-9;
+  }
+
+  uint32_t
+  getNewNonce()
+  {
+    if (m_nonces.size() >= 1000)
+      m_nonces.clear();
+
+    auto randomNonce = random::generateWord32();
+    while (std::find(m_nonces.begin(), m_nonces.end(), randomNonce) != m_nonces.end())
+      randomNonce = random::generateWord32();
+
+    m_nonces.push_back(randomNonce);
+    return randomNonce;
+  }
+
+  uint32_t
+  getOldNonce()
+  {
+    if (m_nonces.empty())
+      return getNewNonce();
+
+    std::uniform_int_distribution<std::size_t> dist(0, m_nonces.size() - 1);
+    return m_nonces[dist(random::getEngine())];
+  }
+
+  /**
+   * \param[out] isRerequest whether the Interest asks again for a recently satisfied name
+   */
+  ndn::Interest
+  prepareInterest(std::size_t patternId, bool& isRerequest)
+  {
+    auto& pattern = m_trafficPatterns[patternId];
+
+    isRerequest = false;
+    if (pattern.m_rerequestPercentage > 0.0 && !pattern.m_recentNames.empty()) {
+      static std::uniform_real_distribution<> rerequestDist(0.0, 100.0);
+      if (rerequestDist(random::getEngine()) < pattern.m_rerequestPercentage) {
+        isRerequest = true;
+        auto interest = makeInterest(pattern, pattern.m_recentNames.select());
+        interest.setMustBeFresh(pattern.m_rerequestMustBeFresh);
+        return interest;
+      }
+    }
+
+    auto member = pattern.selectNameMember();
+    std::optional<ndn::name::Component> seqNum;
+    if (pattern.m_nameAppendSeqNum) {
+      seqNum = ndn::name::Component::fromSequenceNumber(*pattern.m_nameAppendSeqNum);
+      pattern.m_nameAppendSeqNum = *pattern.m_nameAppendSeqNum + 1;
+    }
+    auto nRandomBytes = pattern.m_nameAppendBytes.value_or(0);
+    if (nRandomBytes == 0 && !seqNum) {
+      return makeInterest(pattern, pattern.m_nameTemplate.getName(member));
+    }
+
+    const auto* suffix = seqNum ? &*seqNum : nullptr;
+    if (!pattern.m_nameTemplate.isTemplate()) {
+      return makeInterest(pattern, pattern.m_nameEncoder.encode(nRandomBytes, suffix));
+    }
+    auto prefix = pattern.m_nameTemplate.getName(member);
+    return makeInterest(pattern, NameEncoder::encode(prefix.wireEncode().value_bytes(), nRandomBytes, suffix));
+  }
+
+  /**
+   * \brief Creates an Interest for \p name with the parameters of \p pattern.
+   */
+  ndn::Interest
+  makeInterest(const InterestTrafficConfiguration& pattern, const ndn::Name& name)
+  {
+    ndn::Interest interest(name);
+    interest.setCanBePrefix(pattern.m_canBePrefix);
+    interest.setMustBeFresh(pattern.m_mustBeFresh);
+
+    static std::uniform_int_distribution<unsigned> duplicateNonceDist(1, 100);
+    if (duplicateNonceDist(random::getEngine()) <= pattern.m_nonceDuplicationPercentage)
+      interest.setNonce(getOldNonce());
+    else
+      interest.setNonce(getNewNonce());
+
+    if (pattern.m_interestLifetime >= 0_ms)
+      interest.setInterestLifetime(pattern.m_interestLifetime);
+
+    if (pattern.m_nextHopFaceId > 0)
+      interest.setTag(std::make_shared<ndn::lp::NextHopFaceIdTag>(pattern.m_nextHopFaceId));
+
+    return interest;
+  }
+
+  void
+  onData(const ndn::Interest&, const ndn::Data& data, const InterestContext& context)
+  {
+    if (data.getContentType() == ndn::tlv::ContentType_Nack) {
+      // an overloaded producer refused the Interest, which is not a response
+      onApplicationNack(data, context);
+      return;
+    }
+
+    auto now = m_clock.now();
+    auto patternId = context.patternId;
+    auto& pattern = m_trafficPatterns[patternId];
+    auto& stats = getStatistics(context);
+    stats.m_nInterestsReceived++;
+    if (pattern.m_rerequestPercentage > 0.0) {
+      pattern.m_recentNames.insert(data.getName());
+    }
+
+    std::string_view consistency = "NotChecked";
+    if (pattern.m_expectedContent) {
+      if (readString(data.getContent()) != *pattern.m_expectedContent) {
+        stats.m_nContentInconsistencies++;
+        consistency = "No";
+      }
+      else {
+        consistency = "Yes";
+      }
+    }
+    // formatting the line costs more than receiving the Data, so only do it if it is printed
+    if (!m_wantQuiet) {
+      m_logger.log("Data Received      - PatternType=" + std::to_string(patternId + 1) +
+                   ", GlobalID=" + std::to_string(context.globalRef) +
+                   ", LocalID=" + std::to_string(context.localRef) +
+                   ", Name=" + data.getName().toUri() +
+                   ", IsConsistent=" + std::string(consistency), true, false);
+    }
+
+    std::chrono::nanoseconds rttDuration = now - context.sentTime;
+    std::chrono::nanoseconds responseTime = now - context.intendedTime;
+    double rtt = rttDuration.count() / 1e6;
+    if (m_wantVerbose) {
+      auto rttLine = "RTT                - Name=" + data.getName().toUri() +
+                     ", RTT=" + std::to_string(rtt) + "ms";
+      m_logger.log(rttLine, true, false);
+    }
+    if (stats.m_minimumInterestRoundTripTime > rtt)
+      stats.m_minimumInterestRoundTripTime = rtt;
+    if (stats.m_maximumInterestRoundTripTime < rtt)
+      stats.m_maximumInterestRoundTripTime = rtt;
+    stats.m_totalInterestRoundTripTime += rtt;
+    stats.m_rttHistogram.record(rttDuration);
+    stats.m_responseTimeHistogram.record(responseTime);
+    if (context.isRerequest) {
+      stats.m_nRerequestsSatisfied++;
+      stats.m_rerequestRttHistogram.record(rttDuration);
+    }
+    if (context.burstId != 0 && isSharedData(context.burstId, data)) {
+      stats.m_nSharedDataArrivals++;
+    }
+    if (context.phaseId && isCurrentEpoch(context)) {
+      m_phaseStatistics[*context.phaseId].m_nInterestsReceived++;
+      m_phaseStatistics[*context.phaseId].m_rttHistogram.record(rttDuration);
+      m_phaseStatistics[*context.phaseId].m_responseTimeHistogram.record(responseTime);
+    }
+
+    // the RTT is taken before the validation, whose cost is reported on its own
+    if (pattern.m_validation != DataValidator::Method::NONE) {
+      validateData(data, context);
+    }
+
+    onInterestCompleted(context);
+  }
+
+  void
+  validateData(const ndn::Data& data, const InterestContext& context)
+  {
+    auto patternId = context.patternId;
+    auto startTime = m_clock.now();
+    m_dataValidator.validate(data, m_trafficPatterns[patternId].m_validation,
+      [this, context, startTime] {
+        auto& stats = getStatistics(context);
+        stats.m_nDataValidated++;
+        stats.m_validationTimeHistogram.record(m_clock.now() - startTime);
+      },
+      [this, context, startTime] (const ndn::Data& validatedData, std::string_view reason) {
+        auto& stats = getStatistics(context);
+        stats.m_nValidationFailures++;
+        stats.m_validationTimeHistogram.record(m_clock.now() - startTime);
+        m_logger.log("Validation Failed  - PatternType=" + std::to_string(context.patternId + 1) +
+                     ", GlobalID=" + std::to_string(context.globalRef) +
+                     ", LocalID=" + std::to_string(context.localRef) +
+                     ", Name=" + validatedData.getName().toUri() +
+                     ", Reason=" + std::string(reason), true, false);
+      });
+  }
+
+  void
+  onNack(const ndn::Interest& interest, const ndn::lp::Nack& nack, const InterestContext& context)
+  {
+    auto logLine = "Interest Nack'd    - PatternType=" + std::to_string(context.patternId + 1) +
+                   ", GlobalID=" + std::to_string(context.globalRef) +
+                   ", LocalID=" + std::to_string(context.localRef) +
+                   ", Name=" + interest.getName().toUri() +
+                   ", NackReason=" + boost::lexical_cast<std::string>(nack.getReason());
+    m_logger.log(logLine, true, false);
+
+    auto& stats = getStatistics(context);
+    stats.m_nNacks++;
+    if (nack.getReason() == ndn::lp::NackReason::DUPLICATE) {
+      stats.m_nDuplicateNacks++;
+    }
+    if (context.phaseId && isCurrentEpoch(context)) {
+      m_phaseStatistics[*context.phaseId].m_nNacks++;
+    }
+
+    onInterestCompleted(context);
+  }
+
+  void
+  onApplicationNack(const ndn::Data& data, const InterestContext& context)
+  {
+    auto logLine = "Application Nack   - PatternType=" + std::to_string(context.patternId + 1) +
+                   ", GlobalID=" + std::to_string(context.globalRef) +
+                   ", LocalID=" + std::to_string(context.localRef) +
+                   ", Name=" + data.getName().toUri();
+    m_logger.log(logLine, true, false);
+
+    getStatistics(context).m_nNacks++;
+    if (context.phaseId && isCurrentEpoch(context)) {
+      m_phaseStatistics[*context.phaseId].m_nNacks++;
+    }
+
+    onInterestCompleted(context);
+  }
+
+  void
+  onTimeout(const ndn::Interest& interest, const InterestContext& context)
+  {
+    auto timeToTimeout = m_clock.now() - context.sentTime;
+    auto logLine = "Interest Timed Out - PatternType=" + std::to_string(context.patternId + 1) +
+                   ", GlobalID=" + std::to_string(context.globalRef) +
+                   ", LocalID=" + std::to_string(context.localRef) +
+                   ", Name=" + interest.getName().toUri();
+    m_logger.log(logLine, true, false);
+
+    auto& stats = getStatistics(context);
+    stats.m_nTimeouts++;
+    stats.m_timeoutHistogram.record(timeToTimeout);
+    if (context.phaseId && isCurrentEpoch(context)) {
+      m_phaseStatistics[*context.phaseId].m_nTimeouts++;
+    }
+
+    onInterestCompleted(context);
+  }
+
+  void
+  onInterestCompleted(const InterestContext& context)
+  {
+    m_nOutstandingInterests--;
+    m_patternStatistics[context.patternId].m_nOutstanding--;
+    if (context.burstId != 0) {
+      auto burst = m_bursts.find(context.burstId);
+      if (burst != m_bursts.end() && --burst->second.nOutstanding == 0) {
+        m_bursts.erase(burst);
+      }
+    }
+
+    if (m_isGenerationFinished) {
+      if (m_nOutstandingInterests == 0) {
+        stop();
+      }
+      return;
+    }
+    if (m_pauseStart && !isAtOutstandingLimit()) {
+      resumeGeneration();
+    }
+    if (m_trafficPatterns[context.patternId].m_sustainOutstanding > 0 || m_isRefillBlocked) {
+      m_isRefillBlocked = false;
+      scheduleRefill();
+    }
+  }
+
+  /**
+   * \brief Returns whether \p data was already delivered to another Interest of burst \p burstId.
+   *
+   * When the forwarder aggregates the Interests of a burst, it returns a single Data, which the
+   * face decodes once and delivers to the pending Interests one after another. A shared Data is
+   * thus recognized by its encoding being the one delivered last, whereas Data that arrived
+   * separately are decoded into buffers of their own, even if their contents are identical.
+   */
+  bool
+  isSharedData(uint64_t burstId, const ndn::Data& data)
+  {
+    auto burst = m_bursts.find(burstId);
+    if (burst == m_bursts.end()) {
+      return false;
+    }
+    const auto& wire = data.wireEncode();
+    auto& lastData = burst->second.lastData;
+    if (lastData.hasWire() && lastData.data() == wire.data()) {
+      return true;
+    }
+    lastData = wire;
+    return false;
+  }
+
+  void
+  scheduleRefill()
+  {
+    if (!m_isRefillPending) {
+      m_isRefillPending = true;
+      boost::asio::post(m_io, [this] { refillSustainedPatterns(); });
+    }
+  }
+
+  /**
+   * \brief Tops up the outstanding Interests of the patterns with SustainOutstanding.
+   *
+   * Interests are sent MAX_REFILL_BURST at a time per pattern, so that building up millions of
+   * outstanding Interests does not keep responses from being processed. The refill stops at the
+   * maximum number of outstanding Interests and resumes when one of them completes.
+   */
+  void
+  refillSustainedPatterns()
+  {
+    m_isRefillPending = false;
+    if (m_isGenerationFinished) {
+      return;
+    }
+
+    bool needsMore = false;
+    for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
+      const auto& pattern = m_trafficPatterns[patternId];
+      const auto& stats = m_patternStatistics[patternId];
+      if (pattern.m_sustainOutstanding == 0 || !pattern.m_isEnabled) {
+        continue;
+      }
+      for (int i = 0; i < MAX_REFILL_BURST && stats.m_nOutstanding < pattern.m_sustainOutstanding; i++) {
+        if (m_nMaximumInterests && m_nInterestsSent >= *m_nMaximumInterests) {
+          finishTrafficGeneration("All " + std::to_string(m_nInterestsSent) + " Interests sent");
+          return;
+        }
+        if (isAtOutstandingLimit()) {
+          m_isRefillBlocked = true;
+          return;
+        }
+        bool isRerequest = false;
+        auto interest = prepareInterest(patternId, isRerequest);
+        if (!sendInterest(patternId, std::move(interest), std::nullopt, m_clock.now(), isRerequest)) {
+          // retried when one of the outstanding Interests completes
+          m_isRefillBlocked = true;
+          return;
+        }
+      }
+      needsMore = needsMore || stats.m_nOutstanding < pattern.m_sustainOutstanding;
+    }
+    if (needsMore) {
+      scheduleRefill();
+    }
+  }
+
+  bool
+  isAtOutstandingLimit() const
+  {
+    return m_nMaximumOutstanding && m_nOutstandingInterests >= *m_nMaximumOutstanding;
+  }
+
+  /**
+   * \brief Holds back Interest generation while the maximum number of Interests are outstanding.
+   *
+   * Without a limit, the Interests sent while the network stalls pile up in the pending Interest
+   * table of the face until they time out. The schedule is not shifted by a pause, thus the
+   * Interests that were held back are sent as soon as responses arrive, and the generator lag and
+   * the response times include the pause.
+   */
+  void
+  pauseGeneration()
+  {
+    if (!m_pauseStart) {
+      m_pauseStart = std::chrono::steady_clock::now();
+      m_nPauses++;
+    }
+  }
+
+  void
+  resumeGeneration()
+  {
+    m_totalPausedTime += std::chrono::steady_clock::now() - *m_pauseStart;
+    m_pauseStart.reset();
+    // the timer still holds the intended time of the next Interest, which has already passed
+    m_timer.expires_at(m_timer.expiry());
+    waitForNextInterest();
+  }
+
+  static std::chrono::nanoseconds
+  getInterestLifetime(const InterestTrafficConfiguration& pattern)
+  {
+    return pattern.m_interestLifetime >= 0_ms ? pattern.m_interestLifetime : ndn::DEFAULT_INTEREST_LIFETIME;
+  }
+
+  /**
+   * \brief The first SIGINT or SIGTERM stops Interest generation and drains the outstanding
+   *        Interests, a second one stops the client right away.
+   */
   void
-  logStatistics()
+  waitForSignal()
   {
-    using std::to_string;
-
-    m_logger.log("\n\n== Traffic Report ==\n", false, true);
-    m_logger.log("Total Traffic Pattern Types = " + to_string(m_trafficPatterns.size()), false, true);
-    m_logger.log("Total Interests Sent        = " + to_string(m_nInterestsSent), false, true);
-    m_logger.log("Total Responses Received    = " + to_string(m_nInterestsReceived), false, true);
-    m_logger.log("Total Nacks Received        = " + to_string(m_nNacks), false, true);
+    m_signalSet.async_wait([this] (const boost::system::error_code& ec, int) {
+      if (ec) {
+        return;
+      }
+      if (!m_isGenerationFinished) {
+        finishTrafficGeneration("Interest generation interrupted");
+        waitForSignal();
+        return;
+      }
+      m_logger.log("Interrupted again, stopping without waiting for " +
+                   std::to_string(m_nOutstandingInterests) + " outstanding Interests", true, true);
+      m_drainTimer.cancel();
+      stop();
+    });
+  }
 
-    double loss = 0.0;
-    if (m_nInterestsSent > 0) {
-      loss = (m_nInterestsSent - m_nInterestsReceived) * 100.0 / m_nInterestsSent;
+  /**
+   * \brief Stops Interest generation, e.g., at the end of the load schedule or when interrupted.
+   *
+   * Interests that are still outstanding would otherwise be counted as lost, thus the client
+   * waits until all of them have been satisfied, Nack'ed, or timed out before it exits. Since
+   * this is bounded by the longest InterestLifetime in use, the wait ends after that time even
+   * if the face never reports the outcome of some Interests. A shorter wait can be set with
+   * setDrainPeriod(); the Interests still outstanding at its end are reported as such, and
+   * counted neither as satisfied nor as lost.
+   */
+  void
+  finishTrafficGeneration(const std::string& reason)
+  {
+    if (m_isGenerationFinished) {
+      return;
     }
-    m_logger.log("Total Interest Loss         = " + to_string(loss) + "%", false, true);
-
-    double average = 0.0;
-    double inconsistency = 0.0;
-    if (m_nInterestsReceived > 0) {
-      average = m_totalInterestRoundTripTime / m_nInterestsReceived;
-      inconsistency = m_nContentInconsistencies * 100.0 / m_nInterestsReceived;
+    m_logger.log(reason, true, true);
+    m_isGenerationFinished = true;
+    m_timer.cancel();
+    m_startTimer.cancel();
+    m_durationTimer.cancel();
+    if (m_nOutstandingInterests == 0) {
+      stop();
+      return;
     }
-    m_logger.log("Total Data Inconsistency    = " + to_string(inconsistency) + "%", false, true);
-    m_logger.log("Total Round Trip Time       = " + to_string(m_totalInterestRoundTripTime) + "ms", false, true);
-    m_logger.log("Average Round Trip Time     = " + to_string(average) + "ms\n", false, true);
 
-    for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
-      const auto& pattern = m_trafficPatterns[patternId];
+    std::chrono::nanoseconds drainPeriod = ndn::DEFAULT_INTEREST_LIFETIME;
+    if (!m_trafficPatterns.empty()) {
+      drainPeriod = getInterestLifetime(*std::max_element(m_trafficPatterns.begin(), m_trafficPatterns.end(),
+        [] (const auto& a, const auto& b) { return getInterestLifetime(a) < getInterestLifetime(b); }));
+    }
+    auto slack = DRAIN_SLACK;
+    if (m_drainPeriod && *m_drainPeriod < drainPeriod) {
+      drainPeriod = *m_drainPeriod;
+      slack = 0ms;
+    }
+    m_logger.log("Waiting up to " + formatMilliseconds(drainPeriod) + " for " +
+                 std::to_string(m_nOutstandingInterests) + " outstanding Interests", true, true);
+    // the timeouts themselves may be late under load, so allow some slack
+    m_drainTimer.expires_after(drainPeriod + slack);
+    m_drainTimer.async_wait([this] (const boost::system::error_code& ec) {
+      if (ec) {
+        return;
+      }
+      m_logger.log("WARNING: " + std::to_string(m_nOutstandingInterests) +
+                   " Interests still outstanding at the end of the drain period", true, true);
+      stop();
+    });
+  }
 
-      m_logger.log("Traffic Pattern Type #" + to_string(patternId + 1), false, true);
-      pattern.printTrafficConfiguration(m_logger);
-      m_logger.log("Total Interests Sent        = " + to_string(pattern.m_nInterestsSent), false, true);
-      m_logger.log("Total Responses Received    = " + to_string(pattern.m_nInterestsReceived), false, true);
-      m_logger.log("Total Nacks Received        = " + to_string(pattern.m_nNacks), false, true);
+  void
+  startTrafficGeneration()
+  {
+    m_isGenerationStarted = true;
+    m_runPeriods.start(std::chrono::steady_clock::now());
+    if (auto duration = m_runPeriods.getDuration()) {
+      m_durationTimer.expires_after(*duration);
+      m_durationTimer.async_wait([this] (const boost::system::error_code& ec) {
+        if (!ec) {
+          finishTrafficGeneration("Run duration elapsed");
+        }
+      });
+    }
 
-      loss = 0.0;
-      if (pattern.m_nInterestsSent > 0) {
-        loss = (pattern.m_nInterestsSent - pattern.m_nInterestsReceived) * 100.0 / pattern.m_nInterestsSent;
-      }
-      m_logger.log("Total Interest Loss         = " + to_string(loss) + "%", false, true);
+    if (m_schedule) {
+      m_scheduleStartTime = std::chrono::steady_clock::now();
+      m_timer.expires_at(m_scheduleStartTime);
+    }
+    else if (m_traceReader) {
+      m_traceStartTime = std::chrono::steady_clock::now();
+      m_timer.expires_at(m_traceStartTime);
+    }
+    else {
+      m_timer.expires_after(m_interestInterval);
+    }
+    waitForNextInterest();
 
-      average = 0.0;
-      inconsistency = 0.0;
-      if (pattern.m_nInterestsReceived > 0) {
-        average = pattern.m_totalInterestRoundTripTime / pattern.m_nInterestsReceived;
-        inconsistency = pattern.m_nContentInconsistencies * 100.0 / pattern.m_nInterestsReceived;
-      }
-      m_logger.log("Total Data Inconsistency    = " + to_string(inconsistency) + "%", false, true);
-      m_logger.log("Total Round Trip Time       = " +
-                   to_string(pattern.m_totalInterestRoundTripTime) + "ms", false, true);
-      m_logger.log("Average Round Trip Time     = " + to_string(average) + "ms\n", false, true);
+    if (std::any_of(m_trafficPatterns.begin(), m_trafficPatterns.end(),
+                    [] (const auto& pattern) { return pattern.m_sustainOutstanding > 0; })) {
+      scheduleRefill();
     }
   }
 
+  /**
+   * \brief Connects to the coordinator and waits for it to start the run.
+   */
   bool
-  checkTrafficPatternCorrectness() const
+  joinCoordinatedRun()
   {
-    // TODO
+    try {
+      m_coordinator = LineChannel::connect(m_io, resolveCoordinationEndpoint(m_io, m_coordinatorEndpoint));
+    }
+    catch (const std::exception& e) {
+      m_logger.log("ERROR: Unable to connect to coordinator " + m_coordinatorEndpoint + ": " + e.what(),
+                   false, true);
+      return false;
+    }
+
+    m_coordinator->start([this] (auto line) { processCoordinatorMessage(line); },
+                         [this] {
+                           m_logger.log("ERROR: Lost connection to coordinator", true, true);
+                           m_coordinator = nullptr;
+                           m_hasError = true;
+                           stop();
+                         });
+    m_coordinator->send("HELLO " + boost::asio::ip::host_name() + ':' + std::to_string(::getpid()));
+    m_logger.log("Waiting for coordinator " + m_coordinatorEndpoint + " to start the run", true, true);
     return true;
   }
 
-  uint32_t
-  getNewNonce()
+  void
+  processCoordinatorMessage(std::string_view line)
   {
-    if (m_nonces.size() >= 1000)
-      m_nonces.clear();
+    if (line.substr(0, 6) == "START ") {
+      auto args = line.substr(6);
+      auto pos = args.find(' ');
+      uint64_t startTime = 0;
+      uint64_t reportInterval = 0;
+      if (pos == std::string_view::npos || !parseNumber(args.substr(0, pos), startTime) ||
+          !parseNumber(args.substr(pos + 1), reportInterval) || reportInterval == 0) {
+        m_logger.log("ERROR: Malformed message from coordinator: " + std::string(line), true, true);
+        m_hasError = true;
+        stop();
+        return;
+      }
 
-    auto randomNonce = ndn::random::generateWord32();
-    while (std::find(m_nonces.begin(), m_nonces.end(), randomNonce) != m_nonces.end())
-      randomNonce = ndn::random::generateWord32();
+      // the start time is given in wall-clock time, which is common to all hosts
+      auto delay = std::chrono::system_clock::time_point(std::chrono::microseconds(startTime)) -
+                   std::chrono::system_clock::now();
+      m_logger.log("Run starts in " + formatMilliseconds(std::max<std::chrono::nanoseconds>(delay, 0ns)),
+                   true, true);
+      m_startTimer.expires_after(delay);
+      m_startTimer.async_wait([this] (const boost::system::error_code& ec) {
+        if (!ec && !m_isGenerationFinished) {
+          startTrafficGeneration();
+        }
+      });
+      m_coordinatorReportInterval = std::chrono::milliseconds(reportInterval);
+      m_coordinatorTimer.expires_after(delay);
+      scheduleCoordinatorReport();
+    }
+    else if (line == "STOP") {
+      finishTrafficGeneration("Run stopped by coordinator");
+    }
+    else {
+      m_logger.log("WARNING: Ignoring unknown message from coordinator: " + std::string(line), true, true);
+    }
+  }
 
-    m_nonces.push_back(randomNonce);
-    return randomNonce;
+  void
+  scheduleCoordinatorReport()
+  {
+    m_coordinatorTimer.expires_at(m_coordinatorTimer.expiry() + m_coordinatorReportInterval);
+    m_coordinatorTimer.async_wait([this] (const boost::system::error_code& ec) {
+      if (ec || !m_coordinator) {
+        return;
+      }
+      m_coordinator->send("STATS " + makeWorkerReport().encode());
+      scheduleCoordinatorReport();
+    });
   }
 
-  uint32_t
-  getOldNonce()
+  WorkerReport
+  makeWorkerReport() const
   {
-    if (m_nonces.empty())
-      return getNewNonce();
+    auto total = getTotalStatistics();
+    WorkerReport report;
+    // like the responses, only the Interests of the measurement period
+    report.nInterestsSent = total.m_nInterestsSent;
+    report.nResponses = total.m_nInterestsReceived;
+    report.nNacks = total.m_nNacks;
+    report.nTimeouts = total.m_nTimeouts;
+    report.nContentInconsistencies = total.m_nContentInconsistencies;
+    report.serviceTime = std::move(total.m_rttHistogram);
+    report.responseTime = std::move(total.m_responseTimeHistogram);
+    report.generatorLag = m_generatorLagHistogram;
+    return report;
+  }
 
-    std::uniform_int_distribution<std::size_t> dist(0, m_nonces.size() - 1);
-    return m_nonces[dist(ndn::random::getRandomNumberEngine())];
+  void
+  waitForNextInterest()
+  {
+    m_timer.async_wait([this] (const boost::system::error_code& ec) {
+      if (ec || m_isGenerationFinished) {
+        return;
+      }
+      if (isAtOutstandingLimit()) {
+        pauseGeneration();
+        return;
+      }
+      if (m_traceReader) {
+        replayTrace();
+      }
+      else {
+        generateTraffic();
+      }
+    });
   }
 
-  static auto
-  generateRandomNameComponent(std::size_t length)
+  void
+  scheduleNextInterest()
   {
-    // per ISO C++ std, cannot instantiate uniform_int_distribution with uint8_t
-    static std::uniform_int_distribution<unsigned> dist(std::numeric_limits<uint8_t>::min(),
-                                                        std::numeric_limits<uint8_t>::max());
+    m_timer.expires_at(m_timer.expiry() + m_interestInterval);
+    waitForNextInterest();
+  }
 
-    ndn::Buffer buf(length);
-    for (std::size_t i = 0; i < length; i++) {
-      buf[i] = static_cast<uint8_t>(dist(ndn::random::getRandomNumberEngine()));
+  /**
+   * \brief Changes the Interest generation interval, effective from the last generation tick.
+   */
+  void
+  changeInterestInterval(std::chrono::nanoseconds interval)
+  {
+    auto lastTick = m_timer.expiry() - m_interestInterval;
+    m_interestInterval = interval;
+    // before the start, while paused at the outstanding limit, and once finished, the new interval
+    // only takes effect when generation (re)starts
+    if (!m_isGenerationStarted || m_pauseStart || m_isGenerationFinished) {
+      return;
     }
-    return ndn::name::Component(buf);
+    // this cancels the pending wait, if any
+    m_timer.expires_at(std::max(lastTick + m_interestInterval, std::chrono::steady_clock::now()));
+    waitForNextInterest();
   }
 
-  auto
-  prepareInterest(std::size_t patternId)
+  void
+  generateTraffic()
   {
-    ndn::Interest interest;
-    auto& pattern = m_trafficPatterns[patternId];
-
-    ndn::Name name(pattern.m_name);
-    if (pattern.m_nameAppendBytes > 0) {
-      name.append(generateRandomNameComponent(*pattern.m_nameAppendBytes));
-    }
-    if (pattern.m_nameAppendSeqNum) {
-      auto seqNum = *pattern.m_nameAppendSeqNum;
-      name.appendSequenceNumber(seqNum);
-      pattern.m_nameAppendSeqNum = seqNum + 1;
+    if (m_nMaximumInterests && m_nInterestsSent >= *m_nMaximumInterests) {
+      return;
     }
-    interest.setName(name);
 
-    interest.setCanBePrefix(pattern.m_canBePrefix);
-    interest.setMustBeFresh(pattern.m_mustBeFresh);
-
-    static std::uniform_int_distribution<unsigned> duplicateNonceDist(1, 100);
-    if (duplicateNonceDist(ndn::random::getRandomNumberEngine()) <= pattern.m_nonceDuplicationPercentage)
-      interest.setNonce(getOldNonce());
-    else
-      interest.setNonce(getNewNonce());
+    std::optional<std::size_t> phaseId;
+    if (m_schedule) {
+      auto position = m_schedule->locate(m_timer.expiry() - m_scheduleStartTime);
+      if (!position) {
+        finishTrafficGeneration("Load schedule completed");
+        return;
+      }
 
-    if (pattern.m_interestLifetime >= 0_ms)
-      interest.setInterestLifetime(pattern.m_interestLifetime);
+      phaseId = position->phaseId;
+      auto& phase = m_phaseStatistics[*phaseId];
+      if (!phase.m_startTime) {
+        phase.m_startTime = m_timer.expiry();
+        m_logger.log("Starting load schedule phase #" + std::to_string(*phaseId + 1), true, true);
+      }
 
-    if (pattern.m_nextHopFaceId > 0)
-      interest.setTag(std::make_shared<ndn::lp::NextHopFaceIdTag>(pattern.m_nextHopFaceId));
+      if (position->rate <= 0.0) {
+        // nothing to send for now, check again later
+        m_timer.expires_at(m_timer.expiry() + std::min<std::chrono::nanoseconds>(position->remaining, 10ms));
+        waitForNextInterest();
+        return;
+      }
+      // never step over the beginning of the next phase
+      m_interestInterval = std::clamp(std::chrono::nanoseconds(static_cast<int64_t>(1e9 / position->rate)),
+                                      std::chrono::nanoseconds(1), position->remaining);
+    }
 
-    return interest;
+    static std::uniform_real_distribution<> trafficDist(std::numeric_limits<double>::min(), 100.0);
+    double trafficKey = trafficDist(random::getEngine());
+
+    auto patternId = m_patternSelector.select(trafficKey);
+    if (patternId) {
+      bool isRerequest = false;
+      auto interest = prepareInterest(*patternId, isRerequest);
+      // an Interest that cannot be sent is skipped, and generation goes on with the next tick
+      if (m_trafficPatterns[*patternId].m_burstSize > 1) {
+        sendBurst(*patternId, std::move(interest), phaseId, m_timer.expiry(), isRerequest);
+      }
+      else {
+        sendInterest(*patternId, std::move(interest), phaseId, m_timer.expiry(), isRerequest);
+      }
+    }
+    if (m_nMaximumInterests && m_nInterestsSent >= *m_nMaximumInterests) {
+      finishTrafficGeneration("All " + std::to_string(m_nInterestsSent) + " Interests sent");
+      return;
+    }
+    scheduleNextInterest();
   }
 
+  /**
+   * \brief Sends all trace records that are due, then waits for the next one.
+   *
+   * When the generator falls behind, at most MAX_REPLAY_BURST records are sent back-to-back
+   * before returning to the event loop, so that responses keep being processed while catching up.
+   */
   void
-  onData(const ndn::Interest&, const ndn::Data& data, int globalRef, int localRef,
-         std::size_t patternId, const time::steady_clock::time_point& sentTime)
+  replayTrace()
   {
-    auto now = time::steady_clock::now();
-    auto logLine = "Data Received      - PatternType=" + std::to_string(patternId + 1) +
-                   ", GlobalID=" + std::to_string(globalRef) +
-                   ", LocalID=" + std::to_string(localRef) +
-                   ", Name=" + data.getName().toUri();
+    for (int i = 0; i < MAX_REPLAY_BURST; i++) {
+      if (m_nMaximumInterests && m_nInterestsSent >= *m_nMaximumInterests) {
+        finishTrafficGeneration("All " + std::to_string(m_nInterestsSent) + " Interests sent");
+        return;
+      }
+      if (!m_nextTraceRecord) {
+        finishTrafficGeneration("Trace replay completed");
+        return;
+      }
 
-    m_nInterestsReceived++;
-    m_trafficPatterns[patternId].m_nInterestsReceived++;
+      const auto& record = *m_nextTraceRecord;
+      auto due = m_traceStartTime + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::duration<double, std::micro>(record.offset) / m_traceSpeed);
+      if (due > std::chrono::steady_clock::now()) {
+        m_timer.expires_at(due);
+        waitForNextInterest();
+        return;
+      }
+      if (isAtOutstandingLimit()) {
+        pauseGeneration();
+        return;
+      }
 
-    if (m_trafficPatterns[patternId].m_expectedContent) {
-      std::string receivedContent = readString(data.getContent());
-      if (receivedContent != *m_trafficPatterns[patternId].m_expectedContent) {
-        m_nContentInconsistencies++;
-        m_trafficPatterns[patternId].m_nContentInconsistencies++;
-        logLine += ", IsConsistent=No";
+      try {
+        ndn::Name name(ndn::Block(ndn::make_span(reinterpret_cast<const uint8_t*>(record.name.data()),
+                                                 record.name.size())));
+        auto patternId = findTracePattern(name);
+        const auto& pattern = m_trafficPatterns[patternId];
+        if (pattern.m_isEnabled) {
+          auto interest = makeInterest(pattern, name);
+          interest.setCanBePrefix((record.flags & TraceRecord::CAN_BE_PREFIX) != 0);
+          interest.setMustBeFresh((record.flags & TraceRecord::MUST_BE_FRESH) != 0);
+          sendInterest(patternId, std::move(interest), std::nullopt, due);
+        }
+        m_nTraceRecordsReplayed++;
+        m_nextTraceRecord = m_traceReader->next();
       }
-      else {
-        logLine += ", IsConsistent=Yes";
+      catch (const std::exception& e) {
+        m_logger.log("ERROR: Trace record #" + std::to_string(m_traceReader->getRecordCount()) +
+                     " cannot be replayed: " + e.what(), true, true);
+        m_hasError = true;
+        m_nextTraceRecord.reset();
       }
     }
-    else {
-      logLine += ", IsConsistent=NotChecked";
+
+    m_timer.expires_at(std::chrono::steady_clock::now());
+    waitForNextInterest();
+  }
+
+  /**
+   * \brief Returns the pattern with the longest Name that is a prefix of \p name.
+   */
+  std::size_t
+  findTracePattern(const ndn::Name& name) const
+  {
+    std::size_t bestId = 0;
+    std::optional<std::size_t> bestLength;
+    for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
+      const auto& nameTemplate = m_trafficPatterns[patternId].m_nameTemplate;
+      if ((!bestLength || nameTemplate.size() > *bestLength) && nameTemplate.match(name)) {
+        bestId = patternId;
+        bestLength = nameTemplate.size();
+      }
     }
-    if (!m_wantQuiet) {
-      m_logger.log(logLine, true, false);
+    return bestId;
+  }
+
+  /**
+   * \brief Sends the BurstSize Interests of pattern \p patternId back-to-back, all for the name
+   *        of \p interest and each with a nonce of its own, which a forwarder aggregates.
+   */
+  bool
+  sendBurst(std::size_t patternId, ndn::Interest interest, std::optional<std::size_t> phaseId,
+            std::chrono::steady_clock::time_point intendedTime, bool isRerequest)
+  {
+    auto burstId = ++m_lastBurstId;
+    auto& burst = m_bursts[burstId];
+    bool isSent = true;
+    for (uint32_t i = 0; i < m_trafficPatterns[patternId].m_burstSize; i++) {
+      if (m_nMaximumInterests && m_nInterestsSent >= *m_nMaximumInterests) {
+        break;
+      }
+      // the rest of the burst is not sent, as it would exceed the maximum of outstanding Interests
+      if (isAtOutstandingLimit()) {
+        break;
+      }
+      if (i > 0) {
+        interest.setNonce(getNewNonce());
+      }
+      if (!sendInterest(patternId, interest, phaseId, intendedTime, isRerequest, burstId)) {
+        isSent = false;
+        break;
+      }
+      burst.nOutstanding++;
     }
 
-    double rtt = time::duration_cast<time::nanoseconds>(now - sentTime).count() / 1e6;
-    if (m_wantVerbose) {
-      auto rttLine = "RTT                - Name=" + data.getName().toUri() +
-                     ", RTT=" + std::to_string(rtt) + "ms";
-      m_logger.log(rttLine, true, false);
+    if (burst.nOutstanding > 0) {
+      getStatistics(patternId, m_runPeriods.getPeriod(m_clock.now())).m_nBursts++;
     }
-    if (m_minimumInterestRoundTripTime > rtt)
-      m_minimumInterestRoundTripTime = rtt;
-    if (m_maximumInterestRoundTripTime < rtt)
-      m_maximumInterestRoundTripTime = rtt;
-    if (m_trafficPatterns[patternId].m_minimumInterestRoundTripTime > rtt)
-      m_trafficPatterns[patternId].m_minimumInterestRoundTripTime = rtt;
-    if (m_trafficPatterns[patternId].m_maximumInterestRoundTripTime < rtt)
-      m_trafficPatterns[patternId].m_maximumInterestRoundTripTime = rtt;
-    m_totalInterestRoundTripTime += rtt;
-    m_trafficPatterns[patternId].m_totalInterestRoundTripTime += rtt;
-
-    if (m_nMaximumInterests == globalRef) {
-      stop();
+    else {
+      m_bursts.erase(burstId);
     }
+    return isSent;
   }
 
-  void
-  onNack(const ndn::Interest& interest, const ndn::lp::Nack& nack,
-         int globalRef, int localRef, std::size_t patternId)
+  /**
+   * \brief Expresses \p interest on behalf of pattern \p patternId.
+   * \param intendedTime when the Interest should have been sent according to the schedule
+   * \param isRerequest whether the Interest asks again for a recently satisfied name
+   * \param burstId the burst the Interest belongs to, or zero
+   * \return whether the Interest was handed over to the face
+   */
+  bool
+  sendInterest(std::size_t patternId, ndn::Interest interest, std::optional<std::size_t> phaseId,
+               std::chrono::steady_clock::time_point intendedTime, bool isRerequest = false,
+               uint64_t burstId = 0)
   {
-    auto logLine = "Interest Nack'd    - PatternType=" + std::to_string(patternId + 1) +
-                   ", GlobalID=" + std::to_string(globalRef) +
-                   ", LocalID=" + std::to_string(localRef) +
-                   ", Name=" + interest.getName().toUri() +
-                   ", NackReason=" + boost::lexical_cast<std::string>(nack.getReason());
-    m_logger.log(logLine, true, false);
+    auto now = m_clock.now();
+    auto runPeriod = m_runPeriods.getPeriod(now);
+    auto& stats = getStatistics(patternId, runPeriod);
+    // the Interest is counted only once it has been handed over to the face
+    auto globalRef = m_nInterestsSent + 1;
+    auto localRef = m_nPatternInterestsSent[patternId] + 1;
+    auto slot = storeContext({static_cast<int>(globalRef), static_cast<int>(localRef),
+                              patternId, phaseId, intendedTime, now, isRerequest, burstId, runPeriod,
+                              m_statisticsEpoch});
+    try {
+      // the callbacks only capture the slot of the context, so that they are stored without allocation
+      auto dataCallback = [this, slot] (auto&&... args) {
+        onData(std::forward<decltype(args)>(args)..., releaseContext(slot));
+      };
+      auto nackCallback = [this, slot] (auto&&... args) {
+        onNack(std::forward<decltype(args)>(args)..., releaseContext(slot));
+      };
+      auto timeoutCallback = [this, slot] (auto&&... args) {
+        onTimeout(std::forward<decltype(args)>(args)..., releaseContext(slot));
+      };
+      if (m_rawFace) {
+        m_rawFace->expressInterest(interest, dataCallback, nackCallback, timeoutCallback);
+      }
+      else {
+        m_face->expressInterest(interest, dataCallback, nackCallback, timeoutCallback);
+      }
+      m_nInterestsSent++;
+      m_nPatternInterestsSent[patternId]++;
+      stats.m_nInterestsSent++;
+      if (phaseId) {
+        m_phaseStatistics[*phaseId].m_nInterestsSent++;
+      }
+      updateGeneratorLag(now - intendedTime, now);
+      m_nOutstandingInterests++;
+      // outstanding Interests are counted per pattern, regardless of the period they were sent in
+      m_patternStatistics[patternId].m_nOutstanding++;
+      if (isRerequest) {
+        stats.m_nRerequestsSent++;
+      }
 
-    m_nNacks++;
-    m_trafficPatterns[patternId].m_nNacks++;
+      if (!m_wantQuiet) {
+        auto logLine = "Sending Interest   - PatternType=" + std::to_string(patternId + 1) +
+                       ", GlobalID=" + std::to_string(globalRef) +
+                       ", LocalID=" + std::to_string(localRef) +
+                       ", Name=" + interest.getName().toUri();
+        m_logger.log(logLine, true, false);
+      }
+      return true;
+    }
+    catch (const std::exception& e) {
+      m_logger.log("ERROR: "s + e.what(), true, true);
+      m_hasError = true;
+      // the Interest will never complete, so it is neither counted nor kept outstanding
+      releaseContext(slot);
+      return false;
+    }
+  }
 
-    if (m_nMaximumInterests == globalRef) {
-      stop();
+  /**
+   * \brief Keeps \p context until releaseContext() is called with the returned slot.
+   *
+   * The contexts of all outstanding Interests are kept in one vector whose slots are reused,
+   * thus holding millions of outstanding Interests costs no allocation per Interest.
+   */
+  uint32_t
+  storeContext(const InterestContext& context)
+  {
+    if (m_freeContextSlots.empty()) {
+      m_contexts.push_back(context);
+      return static_cast<uint32_t>(m_contexts.size() - 1);
     }
+    auto slot = m_freeContextSlots.back();
+    m_freeContextSlots.pop_back();
+    m_contexts[slot] = context;
+    return slot;
   }
 
-  void
-  onTimeout(const ndn::Interest& interest, int globalRef, int localRef, std::size_t patternId)
+  InterestContext
+  releaseContext(uint32_t slot)
   {
-    auto logLine = "Interest Timed Out - PatternType=" + std::to_string(patternId + 1) +
-                   ", GlobalID=" + std::to_string(globalRef) +
-                   ", LocalID=" + std::to_string(localRef) +
-                   ", Name=" + interest.getName().toUri();
-    m_logger.log(logLine, true, false);
+    m_freeContextSlots.push_back(slot);
+    return m_contexts[slot];
+  }
 
-    if (m_nMaximumInterests == globalRef) {
-      stop();
+  /**
+   * \brief Returns the statistics that the Interests of pattern \p patternId sent in \p period
+   *        are accounted to.
+   */
+  PatternStatistics&
+  getStatistics(std::size_t patternId, RunPeriods::Period period)
+  {
+    switch (period) {
+      case RunPeriods::Period::WARMUP:
+        return m_warmupStatistics[patternId];
+      case RunPeriods::Period::COOLDOWN:
+        return m_cooldownStatistics[patternId];
+      case RunPeriods::Period::MEASUREMENT:
+        break;
     }
+    return m_patternStatistics[patternId];
   }
 
-  void
-  generateTraffic(boost::asio::steady_timer& timer)
+  /**
+   * \brief Returns the statistics that the outcome of the Interest of \p context is recorded in.
+   *
+   * The outcomes of Interests sent before the last reset go to statistics that are never reported.
+   */
+  PatternStatistics&
+  getStatistics(const InterestContext& context)
   {
-    if (m_nMaximumInterests && m_nInterestsSent >= *m_nMaximumInterests) {
-      return;
+    if (!isCurrentEpoch(context)) {
+      return m_staleStatistics;
     }
+    return getStatistics(context.patternId, context.runPeriod);
+  }
 
-    static std::uniform_real_distribution<> trafficDist(std::numeric_limits<double>::min(), 100.0);
-    double trafficKey = trafficDist(ndn::random::getRandomNumberEngine());
-
-    double cumulativePercentage = 0.0;
-    std::size_t patternId = 0;
-    for (; patternId < m_trafficPatterns.size(); patternId++) {
-      auto& pattern = m_trafficPatterns[patternId];
-      cumulativePercentage += pattern.m_trafficPercentage;
-      if (trafficKey <= cumulativePercentage) {
-        m_nInterestsSent++;
-        pattern.m_nInterestsSent++;
-        auto interest = prepareInterest(patternId);
-        try {
-          int globalRef = m_nInterestsSent;
-          int localRef = pattern.m_nInterestsSent;
-          m_face.expressInterest(interest,
-            [=, now = time::steady_clock::now()] (auto&&... args) {
-              onData(std::forward<decltype(args)>(args)..., globalRef, localRef, patternId, now);
-            },
-            [=] (auto&&... args) {
-              onNack(std::forward<decltype(args)>(args)..., globalRef, localRef, patternId);
-            },
-            [=] (auto&&... args) {
-              onTimeout(std::forward<decltype(args)>(args)..., globalRef, localRef, patternId);
-            });
-
-          if (!m_wantQuiet) {
-            auto logLine = "Sending Interest   - PatternType=" + std::to_string(patternId + 1) +
-                           ", GlobalID=" + std::to_string(m_nInterestsSent) +
-                           ", LocalID=" + std::to_string(pattern.m_nInterestsSent) +
-                           ", Name=" + interest.getName().toUri();
-            m_logger.log(logLine, true, false);
-          }
-
-          timer.expires_at(timer.expiry() + m_interestInterval);
-          timer.async_wait([this, &timer] (auto&&...) { generateTraffic(timer); });
-        }
-        catch (const std::exception& e) {
-          m_logger.log("ERROR: "s + e.what(), true, true);
-        }
-        break;
+  bool
+  isCurrentEpoch(const InterestContext& context) const
+  {
+    return context.statisticsEpoch == m_statisticsEpoch;
+  }
+
+  /**
+   * \brief Records the lag of the generator behind its schedule and detects lag episodes,
+   *        i.e., periods during which the lag exceeds the configured threshold.
+   */
+  void
+  updateGeneratorLag(std::chrono::nanoseconds lag, std::chrono::steady_clock::time_point now)
+  {
+    m_generatorLagHistogram.record(lag);
+
+    if (lag > m_lagThreshold) {
+      if (!m_lagEpisodeStart) {
+        m_lagEpisodeStart = now;
+        m_lagEpisodeMax = 0ns;
+        m_nLagEpisodes++;
+        m_logger.log("WARNING: Generator is lagging behind schedule by " + formatMilliseconds(lag),
+                     true, true);
       }
+      m_lagEpisodeMax = std::max<std::chrono::nanoseconds>(m_lagEpisodeMax, lag);
     }
-
-    if (patternId == m_trafficPatterns.size()) {
-      timer.expires_at(timer.expiry() + m_interestInterval);
-      timer.async_wait([this, &timer] (auto&&...) { generateTraffic(timer); });
+    else if (m_lagEpisodeStart) {
+      std::chrono::nanoseconds duration = now - *m_lagEpisodeStart;
+      m_totalLaggingTime += duration;
+      m_lagEpisodeStart.reset();
+      m_logger.log("Generator caught up with schedule after lagging for " + formatMilliseconds(duration) +
+                   " (maximum lag " + formatMilliseconds(m_lagEpisodeMax) + ")", true, true);
     }
   }
 
   void
   stop()
   {
-    if (m_nContentInconsistencies > 0 || m_nInterestsSent != m_nInterestsReceived) {
+    auto total = getTotalStatistics();
+    for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
+      total.merge(m_warmupStatistics[patternId]);
+      total.merge(m_cooldownStatistics[patternId]);
+    }
+    // both cover the Interests sent since the last reset of the statistics
+    if (total.m_nContentInconsistencies > 0 || total.m_nInterestsSent != total.m_nInterestsReceived) {
       m_hasError = true;
     }
 
+    if (m_coordinator) {
+      try {
+        m_coordinator->sendNow("FINAL " + makeWorkerReport().encode());
+      }
+      catch (const boost::system::system_error& e) {
+        m_logger.log("ERROR: Unable to send final report to coordinator: "s + e.what(), true, true);
+        m_hasError = true;
+      }
+      m_coordinator->close();
+      m_coordinator = nullptr;
+    }
+
     logStatistics();
-    m_face.shutdown();
+    if (m_rawFace) {
+      m_rawFace->shutdown();
+    }
+    else {
+      m_face->shutdown();
+    }
     m_io.stop();
   }
 
 private:
+  static constexpr int MAX_REPLAY_BURST = 64;
+  static constexpr int MAX_REFILL_BURST = 1024;
+  static constexpr std::size_t MAX_REREQUEST_WINDOW = 10000000;
+  static constexpr uint32_t MAX_BURST_SIZE = 65535;
+  static constexpr uint64_t MAX_SUSTAINED_OUTSTANDING = 100000000;
+  static constexpr std::chrono::milliseconds DRAIN_SLACK{100};
+
   Logger m_logger{"NdnTrafficClient"};
   boost::asio::io_context m_io;
   boost::asio::signal_set m_signalSet{m_io, SIGINT, SIGTERM};
-  ndn::Face m_face{m_io};
+  std::shared_ptr<BatchingTransport> m_batchingTransport;
+  std::optional<ndn::Face> m_face;
+  std::optional<RawFace> m_rawFace;
+  boost::asio::steady_timer m_timer{m_io};
+  boost::asio::steady_timer m_coordinatorTimer{m_io};
+  boost::asio::steady_timer m_drainTimer{m_io};
+  boost::asio::steady_timer m_durationTimer{m_io};
+  /// waits for the start time of a coordinated run
+  boost::asio::steady_timer m_startTimer{m_io};
+  boost::asio::steady_timer m_reportTimer{m_io};
+  std::optional<MetricsExporter> m_metricsExporter;
+  std::optional<LocalSocketServer> m_controlServer;
+  std::optional<LoadSchedule> m_schedule;
+  std::optional<TraceReader> m_traceReader;
+  std::shared_ptr<LineChannel> m_coordinator;
 
   std::string m_configurationFile;
   std::string m_timestampFormat;
+  std::string m_metricsSocket;
+  std::string m_controlSocket;
+  std::string m_scheduleFile;
+  std::string m_traceFile;
+  std::string m_validatorConfigFile;
+  std::string m_coordinatorEndpoint;
+  std::chrono::milliseconds m_coordinatorReportInterval{1s};
+  double m_traceSpeed = 1.0;
+  std::chrono::nanoseconds m_lagThreshold{10ms};
   std::optional<uint64_t> m_nMaximumInterests;
-  std::chrono::milliseconds m_interestInterval{1s};
+  std::optional<uint64_t> m_nMaximumOutstanding;
+  std::optional<std::chrono::milliseconds> m_reportInterval;
+  std::optional<std::chrono::milliseconds> m_drainPeriod;
+  std::chrono::nanoseconds m_interestInterval{1s};
 
   std::vector<InterestTrafficConfiguration> m_trafficPatterns;
+  std::vector<PatternStatistics> m_patternStatistics;
+  /// statistics of the Interests sent during the warm-up and the cool-down, not in m_patternStatistics
+  std::vector<PatternStatistics> m_warmupStatistics;
+  std::vector<PatternStatistics> m_cooldownStatistics;
+  RunPeriods m_runPeriods;
+  /// incremented by every reset of the statistics
+  uint32_t m_statisticsEpoch = 0;
+  /// outcomes of the Interests sent before the last reset, which are discarded
+  PatternStatistics m_staleStatistics;
+  /// Interests sent per pattern since the start, which number them like m_nInterestsSent
+  std::vector<uint64_t> m_nPatternInterestsSent;
+  PatternSelector m_patternSelector;
   std::vector<uint32_t> m_nonces;
+  DataValidator m_dataValidator;
+  std::vector<PhaseStatistics> m_phaseStatistics;
+  std::chrono::steady_clock::time_point m_scheduleStartTime;
+  std::optional<TraceRecord> m_nextTraceRecord;
+  std::chrono::steady_clock::time_point m_traceStartTime;
+  uint64_t m_nTraceRecordsReplayed = 0;
+  uint64_t m_nOutstandingInterests = 0;
+  std::vector<InterestContext> m_contexts;
+  std::vector<uint32_t> m_freeContextSlots;
+  std::unordered_map<uint64_t, Burst> m_bursts;
+  uint64_t m_lastBurstId = 0;
+  bool m_isRefillPending = false;
+  /// whether a refill stopped at the outstanding limit and waits for an Interest to complete
+  bool m_isRefillBlocked = false;
   uint64_t m_nInterestsSent = 0;
-  uint64_t m_nInterestsReceived = 0;
-  uint64_t m_nNacks = 0;
-  uint64_t m_nContentInconsistencies = 0;
+  uint64_t m_nInterestsReported = 0;
 
-  // RTT is stored as milliseconds with fractional sub-milliseconds precision
-  double m_minimumInterestRoundTripTime = std::numeric_limits<double>::max();
-  double m_maximumInterestRoundTripTime = 0;
-  double m_totalInterestRoundTripTime = 0;
+  Histogram m_generatorLagHistogram;
+  std::optional<std::chrono::steady_clock::time_point> m_lagEpisodeStart;
+  std::chrono::nanoseconds m_lagEpisodeMax{0};
+  std::chrono::nanoseconds m_totalLaggingTime{0};
+  uint64_t m_nLagEpisodes = 0;
+  std::optional<std::chrono::steady_clock::time_point> m_pauseStart;
+  std::chrono::nanoseconds m_totalPausedTime{0};
+  uint64_t m_nPauses = 0;
 
   bool m_wantQuiet = false;
   bool m_wantVerbose = false;
+  bool m_wantBatchedWrites = false;
+  bool m_wantRawEngine = false;
+  ExecutionMode m_executionMode;
+  TimestampSource::Type m_clockType = TimestampSource::Type::MONOTONIC;
+  TimestampSource m_clock;
+  bool m_isGenerationStarted = false;
+  bool m_isGenerationFinished = false;
   bool m_hasError = false;
 };
 
@@ -580,9 +2501,12 @@ static void
 usage(std::ostream& os, std::string_view programName, const po::options_description& desc)
 {
   os << "Usage: " << programName << " [options] <Traffic_Configuration_File>\n"
+     << "       " << programName << " [options] --trace <Trace_File> [Traffic_Configuration_File]\n"
      << "\n"
      << "Generate Interest traffic as per provided Traffic_Configuration_File.\n"
      << "Interests are continuously generated unless a total number is specified.\n"
+     << "In trace mode, the recorded Interests are replayed and the traffic patterns,\n"
+     << "if any, only provide the Interest parameters for the Names under their prefixes.\n"
      << "Set the environment variable NDN_TRAFFIC_LOGFOLDER to redirect output to a log file.\n"
      << "\n"
      << desc;
@@ -601,8 +2525,40 @@ main(int argc, char* argv[])
     ("interval,i",  po::value<std::chrono::milliseconds::rep>()->default_value(1000),
                     "Interest generation interval in milliseconds")
     ("timestamp-format,t", po::value<std::string>(&timestampFormat), "format string for timestamp output")
+    ("coarse-timestamps", po::bool_switch(), "take log timestamps from a cheaper clock with millisecond resolution")
     ("quiet,q",     po::bool_switch(), "turn off logging of Interest generation and Data reception")
     ("verbose,v",   po::bool_switch(), "log additional per-packet information")
+    ("metrics-socket", po::value<std::string>(), "serve live metrics in Prometheus format on this Unix socket")
+    ("control-socket", po::value<std::string>(), "accept runtime control commands on this Unix socket")
+    ("schedule,s",  po::value<std::string>(), "follow the load schedule in this file instead of a fixed interval")
+    ("max-outstanding", po::value<uint64_t>(),
+                    "pause Interest generation while this many Interests await a response")
+    ("report-interval", po::value<std::chrono::milliseconds::rep>(),
+                    "log the progress and memory usage every this many milliseconds")
+    ("drain-period", po::value<std::chrono::milliseconds::rep>(),
+                    "once generation stops, wait at most this many milliseconds for outstanding Interests "
+                    "(default: the longest InterestLifetime)")
+    ("lag-threshold", po::value<std::chrono::milliseconds::rep>()->default_value(10),
+                    "warn when sending falls behind schedule by more than this many milliseconds")
+    ("duration",    po::value<std::string>(), "stop generating Interests after this time, e.g., 90s or 10m")
+    ("warmup",      po::value<std::string>(), "report the Interests sent during this initial time separately")
+    ("cooldown",    po::value<std::string>(),
+                    "report the Interests sent during this final time of the --duration separately")
+    ("trace",       po::value<std::string>(), "replay the Interests recorded in this binary trace file")
+    ("trace-speed", po::value<double>()->default_value(1.0), "replay the trace this many times faster")
+    ("batch-writes", po::bool_switch(), "write all Interests of one generation tick to the forwarder at once")
+    ("engine",      po::value<std::string>()->default_value("face"),
+                    "packet engine: 'face' (ndn-cxx Face) or 'raw' (direct forwarder connection, implies --batch-writes)")
+    ("cpu-affinity", po::value<std::string>(), "run on these CPUs only, e.g., 2 or 4-7,12")
+    ("numa-local",  po::bool_switch(), "allocate memory on the NUMA node of the CPU running the client")
+    ("busy-poll",   po::bool_switch(), "poll for events in a loop instead of sleeping, to cut wakeup latency")
+    ("clock",       po::value<std::string>()->default_value("monotonic"),
+                    "clock for measuring RTTs: 'monotonic' or 'tsc' (CPU time stamp counter, x86 only)")
+    ("validator-config", po::value<std::string>(),
+                    "validate Data of patterns with Validation=anchor using this ndn-cxx validator configuration")
+    ("seed",        po::value<uint64_t>(), "make the generated traffic reproducible by seeding the random numbers")
+    ("coordinator", po::value<std::string>(),
+                    "take part in a coordinated run, connecting to unix:<path> or <host>:<port>")
     ;
 
   po::options_description hiddenOptions;
@@ -635,7 +2591,7 @@ main(int argc, char* argv[])
     return 0;
   }
 
-  if (configFile.empty()) {
+  if (configFile.empty() && vm.count("trace") == 0) {
     usage(std::cerr, argv[0], visibleOptions);
     return 2;
   }
@@ -664,6 +2620,10 @@ main(int argc, char* argv[])
     client.setTimestampFormat(std::move(timestampFormat));
   }
 
+  if (vm["coarse-timestamps"].as<bool>()) {
+    client.setCoarseTimestamps();
+  }
+
   if (vm["quiet"].as<bool>()) {
     if (vm["verbose"].as<bool>()) {
       std::cerr << "ERROR: cannot set both '--quiet' and '--verbose'\n";
@@ -676,5 +2636,124 @@ main(int argc, char* argv[])
     client.setVerboseLogging();
   }
 
+  if (vm.count("lag-threshold") > 0) {
+    std::chrono::milliseconds threshold(vm["lag-threshold"].as<std::chrono::milliseconds::rep>());
+    if (threshold < 0ms) {
+      std::cerr << "ERROR: the argument for option '--lag-threshold' cannot be negative\n";
+      return 2;
+    }
+    client.setLagThreshold(threshold);
+  }
+
+  if (vm.count("max-outstanding") > 0) {
+    auto maxOutstanding = vm["max-outstanding"].as<uint64_t>();
+    if (maxOutstanding == 0) {
+      std::cerr << "ERROR: the argument for option '--max-outstanding' must be positive\n";
+      return 2;
+    }
+    client.setMaximumOutstanding(maxOutstanding);
+  }
+
+  if (vm.count("report-interval") > 0) {
+    std::chrono::milliseconds interval(vm["report-interval"].as<std::chrono::milliseconds::rep>());
+    if (interval <= 0ms) {
+      std::cerr << "ERROR: the argument for option '--report-interval' must be positive\n";
+      return 2;
+    }
+    client.setReportInterval(interval);
+  }
+
+  try {
+    auto option = [&vm] (const char* name) {
+      return vm.count(name) > 0 ? vm[name].as<std::string>() : "";
+    };
+    client.setRunPeriods(ndntg::RunPeriods::parse(option("duration"), option("warmup"), option("cooldown")));
+  }
+  catch (const std::invalid_argument& e) {
+    std::cerr << "ERROR: " << e.what() << "\n";
+    return 2;
+  }
+
+  if (vm.count("drain-period") > 0) {
+    std::chrono::milliseconds period(vm["drain-period"].as<std::chrono::milliseconds::rep>());
+    if (period < 0ms) {
+      std::cerr << "ERROR: the argument for option '--drain-period' cannot be negative\n";
+      return 2;
+    }
+    client.setDrainPeriod(period);
+  }
+
+  if (vm.count("metrics-socket") > 0) {
+    client.setMetricsSocket(vm["metrics-socket"].as<std::string>());
+  }
+
+  if (vm.count("control-socket") > 0) {
+    client.setControlSocket(vm["control-socket"].as<std::string>());
+  }
+
+  if (vm.count("schedule") > 0) {
+    client.setLoadSchedule(vm["schedule"].as<std::string>());
+  }
+
+  if (vm.count("trace") > 0) {
+    if (vm.count("schedule") > 0) {
+      std::cerr << "ERROR: cannot set both '--schedule' and '--trace'\n";
+      return 2;
+    }
+    auto speed = vm["trace-speed"].as<double>();
+    if (!std::isfinite(speed) || speed <= 0.0) {
+      std::cerr << "ERROR: the argument for option '--trace-speed' must be positive\n";
+      return 2;
+    }
+    client.setTrace(vm["trace"].as<std::string>(), speed);
+  }
+
+  if (vm["batch-writes"].as<bool>()) {
+    client.setBatchedWrites();
+  }
+
+  auto engine = vm["engine"].as<std::string>();
+  if (engine == "raw") {
+    client.setRawEngine();
+  }
+  else if (engine != "face") {
+    std::cerr << "ERROR: the argument for option '--engine' must be 'face' or 'raw'\n";
+    return 2;
+  }
+
+  ndntg::ExecutionMode executionMode;
+  if (vm.count("cpu-affinity") > 0) {
+    auto cpus = ndntg::ExecutionMode::parseCpuList(vm["cpu-affinity"].as<std::string>());
+    if (!cpus) {
+      std::cerr << "ERROR: the argument for option '--cpu-affinity' must be a list of CPUs, e.g., 0,2-3\n";
+      return 2;
+    }
+    executionMode.cpus = std::move(*cpus);
+  }
+  executionMode.wantLocalMemory = vm["numa-local"].as<bool>();
+  executionMode.wantBusyPoll = vm["busy-poll"].as<bool>();
+  client.setExecutionMode(std::move(executionMode));
+
+  auto clock = vm["clock"].as<std::string>();
+  if (clock == "tsc") {
+    client.setClock(ndntg::TimestampSource::Type::TSC);
+  }
+  else if (clock != "monotonic") {
+    std::cerr << "ERROR: the argument for option '--clock' must be 'monotonic' or 'tsc'\n";
+    return 2;
+  }
+
+  if (vm.count("validator-config") > 0) {
+    client.setValidatorConfig(vm["validator-config"].as<std::string>());
+  }
+
+  if (vm.count("seed") > 0) {
+    ndntg::random::seed(vm["seed"].as<uint64_t>());
+  }
+
+  if (vm.count("coordinator") > 0) {
+    client.setCoordinator(vm["coordinator"].as<std::string>());
+  }
+
   return client.run();
 }
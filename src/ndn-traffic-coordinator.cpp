@@ -0,0 +1,559 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "coordination.hpp"
+#include "logger.hpp"
+
+#include <ndn-cxx/util/random.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/signal_set.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/core/noncopyable.hpp>
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+using namespace std::chrono_literals;
+
+namespace ndntg {
+
+using namespace std::string_literals;
+
+/**
+ * \brief Starts several traffic clients at the same time and merges their statistics.
+ */
+class NdnTrafficCoordinator : boost::noncopyable
+{
+public:
+  NdnTrafficCoordinator(std::string endpoint, std::size_t nWorkers)
+    : m_endpoint(std::move(endpoint))
+    , m_nExpectedWorkers(nWorkers)
+  {
+  }
+
+  void
+  setStartDelay(std::chrono::milliseconds delay)
+  {
+    m_startDelay = delay;
+  }
+
+  void
+  setReportInterval(std::chrono::milliseconds interval)
+  {
+    m_reportInterval = interval;
+  }
+
+  void
+  setTimestampFormat(std::string format)
+  {
+    m_timestampFormat = std::move(format);
+  }
+
+  void
+  setQuietLogging()
+  {
+    m_wantQuiet = true;
+  }
+
+  int
+  run()
+  {
+    m_logger.initialize(std::to_string(ndn::random::generateWord32()), m_timestampFormat);
+
+    try {
+      auto endpoint = resolveCoordinationEndpoint(m_io, m_endpoint);
+      if (endpoint.protocol().family() == AF_UNIX) {
+        m_socketPath = m_endpoint.substr(5);
+        std::error_code ec;
+        if (std::filesystem::is_socket(m_socketPath, ec)) {
+          std::filesystem::remove(m_socketPath, ec);
+        }
+      }
+      m_acceptor.open(endpoint.protocol());
+      if (endpoint.protocol().family() != AF_UNIX) {
+        m_acceptor.set_option(boost::asio::socket_base::reuse_address(true));
+      }
+      m_acceptor.bind(endpoint);
+      m_acceptor.listen();
+    }
+    catch (const std::exception& e) {
+      m_logger.log("ERROR: Unable to listen on " + m_endpoint + ": " + e.what(), false, true);
+      return 2;
+    }
+
+    m_signalSet.async_wait([this] (const boost::system::error_code& ec, int) {
+      if (!ec) {
+        onSignal();
+      }
+    });
+    accept();
+    m_logger.log("Waiting for " + std::to_string(m_nExpectedWorkers) + " worker(s) on " + m_endpoint,
+                 true, true);
+
+    m_io.run();
+    return m_hasError ? 1 : 0;
+  }
+
+private:
+  struct Worker
+  {
+    std::shared_ptr<LineChannel> channel;
+    std::string name;
+    WorkerReport report;
+    bool hasJoined = false;
+    bool isFinished = false;
+    bool isLost = false;
+  };
+
+  void
+  accept()
+  {
+    m_acceptor.async_accept([this] (const boost::system::error_code& ec, CoordinationProtocol::socket socket) {
+      if (ec == boost::asio::error::operation_aborted) {
+        return;
+      }
+      if (!ec) {
+        auto id = m_workers.size();
+        auto& worker = m_workers.emplace_back();
+        worker.channel = std::make_shared<LineChannel>(std::move(socket));
+        worker.channel->start([this, id] (auto line) { onWorkerMessage(id, line); },
+                              [this, id] { onWorkerDisconnected(id); });
+      }
+      accept();
+    });
+  }
+
+  void
+  onWorkerMessage(std::size_t id, std::string_view line)
+  {
+    auto& worker = m_workers[id];
+    auto pos = line.find(' ');
+    auto type = line.substr(0, pos);
+    auto args = pos == std::string_view::npos ? std::string_view{} : line.substr(pos + 1);
+
+    if (type == "HELLO" && !worker.hasJoined) {
+      worker.name = args;
+      worker.hasJoined = true;
+      m_nJoinedWorkers++;
+      m_logger.log("Worker " + worker.name + " joined (" + std::to_string(m_nJoinedWorkers) + "/" +
+                   std::to_string(m_nExpectedWorkers) + ")", true, true);
+      if (m_nJoinedWorkers == m_nExpectedWorkers) {
+        startRun();
+      }
+    }
+    else if ((type == "STATS" || type == "FINAL") && worker.hasJoined) {
+      if (!worker.report.decode(args)) {
+        m_logger.log("WARNING: Ignoring malformed report from worker " + worker.name, true, true);
+      }
+      if (type == "FINAL") {
+        worker.channel->close();
+        if (m_isStarted) {
+          worker.isFinished = true;
+          m_logger.log("Worker " + worker.name + " finished", true, true);
+          checkCompletion();
+        }
+        else {
+          leave(worker);
+        }
+      }
+    }
+    else {
+      m_logger.log("WARNING: Ignoring unexpected message from worker " +
+                   (worker.name.empty() ? "#" + std::to_string(id + 1) : worker.name) + ": " + std::string(line),
+                   true, true);
+    }
+  }
+
+  void
+  onWorkerDisconnected(std::size_t id)
+  {
+    auto& worker = m_workers[id];
+    if (!worker.hasJoined) {
+      return;
+    }
+    if (!m_isStarted) {
+      leave(worker);
+      return;
+    }
+
+    // the last report received from the worker is kept
+    worker.isLost = true;
+    m_hasError = true;
+    m_logger.log("WARNING: Lost connection to worker " + worker.name, true, true);
+    checkCompletion();
+  }
+
+  /**
+   * \brief Forgets a worker that disconnected before the start of the run.
+   */
+  void
+  leave(Worker& worker)
+  {
+    worker.hasJoined = false;
+    m_nJoinedWorkers--;
+    m_logger.log("Worker " + worker.name + " left before the start (" + std::to_string(m_nJoinedWorkers) +
+                 "/" + std::to_string(m_nExpectedWorkers) + ")", true, true);
+  }
+
+  void
+  startRun()
+  {
+    m_isStarted = true;
+    closeAcceptor();
+
+    auto startTime = std::chrono::system_clock::now() + m_startDelay;
+    auto startTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(startTime.time_since_epoch());
+    auto message = "START " + std::to_string(startTimeUs.count()) + " " + std::to_string(m_reportInterval.count());
+    for (auto& worker : m_workers) {
+      if (worker.hasJoined) {
+        worker.channel->send(message);
+      }
+    }
+    m_logger.log("All workers joined, starting the run in " + std::to_string(m_startDelay.count()) + "ms",
+                 true, true);
+
+    m_progressTimer.expires_after(m_startDelay);
+    scheduleProgressReport();
+  }
+
+  void
+  scheduleProgressReport()
+  {
+    m_progressTimer.expires_at(m_progressTimer.expiry() + m_reportInterval);
+    m_progressTimer.async_wait([this] (const boost::system::error_code& ec) {
+      if (ec) {
+        return;
+      }
+      if (!m_wantQuiet) {
+        logProgress();
+      }
+      scheduleProgressReport();
+    });
+  }
+
+  WorkerReport
+  getTotalReport() const
+  {
+    WorkerReport total;
+    for (const auto& worker : m_workers) {
+      if (worker.hasJoined) {
+        total.merge(worker.report);
+      }
+    }
+    return total;
+  }
+
+  static std::string
+  formatMilliseconds(std::chrono::nanoseconds duration)
+  {
+    return std::to_string(duration.count() / 1e6) + "ms";
+  }
+
+  /**
+   * \brief Returns \p count as a percentage of the Interests that were answered, Nack'ed, or timed out.
+   */
+  static double
+  getOutcomePercentage(uint64_t count, const WorkerReport& report)
+  {
+    auto nCompleted = report.nResponses + report.nNacks + report.nTimeouts;
+    return nCompleted > 0 ? count * 100.0 / nCompleted : 0.0;
+  }
+
+  void
+  logProgress()
+  {
+    using std::to_string;
+
+    auto total = getTotalReport();
+    double rate = (total.nInterestsSent - m_nLastInterestsSent) /
+                  std::chrono::duration<double>(m_reportInterval).count();
+    m_nLastInterestsSent = total.nInterestsSent;
+
+    m_logger.log("Progress - Sent=" + to_string(total.nInterestsSent) +
+                 ", Responses=" + to_string(total.nResponses) +
+                 ", Nacks=" + to_string(total.nNacks) +
+                 ", Timeouts=" + to_string(total.nTimeouts) +
+                 ", Rate=" + to_string(rate) + "/s" +
+                 ", MedianRTT=" + formatMilliseconds(total.serviceTime.getPercentile(50)) +
+                 ", 99thPctRTT=" + formatMilliseconds(total.serviceTime.getPercentile(99)),
+                 true, true);
+  }
+
+  void
+  logReport(const WorkerReport& report)
+  {
+    using std::to_string;
+
+    m_logger.log("Total Interests Sent        = " + to_string(report.nInterestsSent), false, true);
+    m_logger.log("Total Responses Received    = " + to_string(report.nResponses), false, true);
+    m_logger.log("Total Nacks Received        = " + to_string(report.nNacks), false, true);
+    m_logger.log("Total Timeouts              = " + to_string(report.nTimeouts), false, true);
+    m_logger.log("Total Interest Loss         = " + to_string(getOutcomePercentage(report.nTimeouts, report)) + "%",
+                 false, true);
+    m_logger.log("Total Nack Percentage       = " + to_string(getOutcomePercentage(report.nNacks, report)) + "%",
+                 false, true);
+    double inconsistency = 0.0;
+    if (report.nResponses > 0) {
+      inconsistency = report.nContentInconsistencies * 100.0 / report.nResponses;
+    }
+    m_logger.log("Total Data Inconsistency    = " + to_string(inconsistency) + "%", false, true);
+    m_logger.log("Average Round Trip Time     = " + formatMilliseconds(report.serviceTime.getMean()),
+                 false, true);
+    m_logger.log("Median Service Time         = " + formatMilliseconds(report.serviceTime.getPercentile(50)),
+                 false, true);
+    m_logger.log("99th Pct Service Time       = " + formatMilliseconds(report.serviceTime.getPercentile(99)),
+                 false, true);
+    m_logger.log("Maximum Service Time        = " + formatMilliseconds(report.serviceTime.getMax()), false, true);
+    m_logger.log("Median Response Time        = " + formatMilliseconds(report.responseTime.getPercentile(50)),
+                 false, true);
+    m_logger.log("99th Pct Response Time      = " + formatMilliseconds(report.responseTime.getPercentile(99)),
+                 false, true);
+    m_logger.log("Maximum Response Time       = " + formatMilliseconds(report.responseTime.getMax()), false, true);
+    m_logger.log("99th Pct Generator Lag      = " + formatMilliseconds(report.generatorLag.getPercentile(99)),
+                 false, true);
+    m_logger.log("Maximum Generator Lag       = " + formatMilliseconds(report.generatorLag.getMax()) + "\n",
+                 false, true);
+  }
+
+  void
+  logStatistics()
+  {
+    using std::to_string;
+
+    std::size_t nLost = 0;
+    for (const auto& worker : m_workers) {
+      nLost += worker.isLost;
+    }
+
+    m_logger.log("\n\n== Coordinated Run Report ==\n", false, true);
+    m_logger.log("Total Workers               = " + to_string(m_nJoinedWorkers), false, true);
+    m_logger.log("Workers Lost                = " + to_string(nLost), false, true);
+    auto total = getTotalReport();
+    logReport(total);
+
+    std::size_t workerId = 0;
+    for (const auto& worker : m_workers) {
+      if (!worker.hasJoined) {
+        continue;
+      }
+      m_logger.log("Worker #" + to_string(++workerId) + " - " + worker.name +
+                   (worker.isLost ? " (lost, last report)" : ""), false, true);
+      logReport(worker.report);
+    }
+
+    if (total.nContentInconsistencies > 0 || total.nInterestsSent != total.nResponses) {
+      m_hasError = true;
+    }
+  }
+
+  void
+  checkCompletion()
+  {
+    for (const auto& worker : m_workers) {
+      if (worker.hasJoined && !worker.isFinished && !worker.isLost) {
+        return;
+      }
+    }
+    stop();
+  }
+
+  void
+  onSignal()
+  {
+    if (!m_isStarted) {
+      m_logger.log("Run aborted before the start", true, true);
+      m_hasError = true;
+      stop();
+      return;
+    }
+
+    // workers answer STOP with their final report, a second signal stops without waiting
+    m_logger.log("Stopping the run", true, true);
+    for (auto& worker : m_workers) {
+      if (worker.hasJoined && !worker.isFinished && !worker.isLost) {
+        worker.channel->send("STOP");
+      }
+    }
+    m_signalSet.async_wait([this] (const boost::system::error_code& ec, int) {
+      if (!ec) {
+        m_hasError = true;
+        stop();
+      }
+    });
+  }
+
+  void
+  closeAcceptor()
+  {
+    if (!m_acceptor.is_open()) {
+      return;
+    }
+    boost::system::error_code ec;
+    m_acceptor.close(ec);
+    if (!m_socketPath.empty()) {
+      std::error_code fsEc;
+      std::filesystem::remove(m_socketPath, fsEc);
+    }
+  }
+
+  void
+  stop()
+  {
+    if (m_isStarted) {
+      logStatistics();
+    }
+
+    closeAcceptor();
+    for (auto& worker : m_workers) {
+      worker.channel->close();
+    }
+    m_progressTimer.cancel();
+    m_signalSet.cancel();
+    m_io.stop();
+  }
+
+private:
+  Logger m_logger{"NdnTrafficCoordinator"};
+  boost::asio::io_context m_io;
+  boost::asio::signal_set m_signalSet{m_io, SIGINT, SIGTERM};
+  boost::asio::steady_timer m_progressTimer{m_io};
+  CoordinationAcceptor m_acceptor{m_io};
+
+  const std::string m_endpoint;
+  const std::size_t m_nExpectedWorkers;
+  std::string m_socketPath;
+  std::string m_timestampFormat;
+  std::chrono::milliseconds m_startDelay{2s};
+  std::chrono::milliseconds m_reportInterval{1s};
+
+  std::vector<Worker> m_workers;
+  std::size_t m_nJoinedWorkers = 0;
+  uint64_t m_nLastInterestsSent = 0;
+
+  bool m_wantQuiet = false;
+  bool m_isStarted = false;
+  bool m_hasError = false;
+};
+
+} // namespace ndntg
+
+namespace po = boost::program_options;
+
+static void
+usage(std::ostream& os, std::string_view programName, const po::options_description& desc)
+{
+  os << "Usage: " << programName << " [options] --workers <N> <Endpoint>\n"
+     << "\n"
+     << "Coordinate a run of N traffic clients started with --coordinator <Endpoint>.\n"
+     << "Endpoint is either unix:<path> or <host>:<port>. Once all clients have connected,\n"
+     << "they are started at the same time and their statistics are merged into one report.\n"
+     << "Set the environment variable NDN_TRAFFIC_LOGFOLDER to redirect output to a log file.\n"
+     << "\n"
+     << desc;
+}
+
+int
+main(int argc, char* argv[])
+{
+  std::string endpoint;
+  std::string timestampFormat;
+
+  po::options_description visibleOptions("Options");
+  visibleOptions.add_options()
+    ("help,h",      "print this help message and exit")
+    ("workers,w",   po::value<std::size_t>(), "number of clients taking part in the run")
+    ("start-delay", po::value<std::chrono::milliseconds::rep>()->default_value(2000),
+                    "start the run this many milliseconds after the last client has connected")
+    ("report-interval", po::value<std::chrono::milliseconds::rep>()->default_value(1000),
+                    "interval in milliseconds between statistics reports of the clients")
+    ("timestamp-format,t", po::value<std::string>(&timestampFormat), "format string for timestamp output")
+    ("quiet,q",     po::bool_switch(), "turn off logging of the progress of the run")
+    ;
+
+  po::options_description hiddenOptions;
+  hiddenOptions.add_options()
+    ("endpoint", po::value<std::string>(&endpoint))
+    ;
+
+  po::positional_options_description posOptions;
+  posOptions.add("endpoint", -1);
+
+  po::options_description allOptions;
+  allOptions.add(visibleOptions).add(hiddenOptions);
+
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv).options(allOptions).positional(posOptions).run(), vm);
+    po::notify(vm);
+  }
+  catch (const po::error& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 2;
+  }
+  catch (const boost::bad_any_cast& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 2;
+  }
+
+  if (vm.count("help") > 0) {
+    usage(std::cout, argv[0], visibleOptions);
+    return 0;
+  }
+
+  if (endpoint.empty() || vm.count("workers") == 0) {
+    usage(std::cerr, argv[0], visibleOptions);
+    return 2;
+  }
+
+  auto nWorkers = vm["workers"].as<std::size_t>();
+  if (nWorkers == 0) {
+    std::cerr << "ERROR: the argument for option '--workers' must be positive\n";
+    return 2;
+  }
+  ndntg::NdnTrafficCoordinator coordinator(std::move(endpoint), nWorkers);
+
+  std::chrono::milliseconds startDelay(vm["start-delay"].as<std::chrono::milliseconds::rep>());
+  if (startDelay < 0ms) {
+    std::cerr << "ERROR: the argument for option '--start-delay' cannot be negative\n";
+    return 2;
+  }
+  coordinator.setStartDelay(startDelay);
+
+  std::chrono::milliseconds reportInterval(vm["report-interval"].as<std::chrono::milliseconds::rep>());
+  if (reportInterval <= 0ms) {
+    std::cerr << "ERROR: the argument for option '--report-interval' must be positive\n";
+    return 2;
+  }
+  coordinator.setReportInterval(reportInterval);
+
+  if (!timestampFormat.empty()) {
+    coordinator.setTimestampFormat(std::move(timestampFormat));
+  }
+
+  if (vm["quiet"].as<bool>()) {
+    coordinator.setQuietLogging();
+  }
+
+  return coordinator.run();
+}
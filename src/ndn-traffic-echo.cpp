@@ -0,0 +1,525 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "batching-transport.hpp"
+#include "logger.hpp"
+#include "raw-face.hpp"
+
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/security/signing-helpers.hpp>
+#include <ndn-cxx/transport/unix-transport.hpp>
+#include <ndn-cxx/util/random.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/signal_set.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/core/noncopyable.hpp>
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+using namespace std::chrono_literals;
+
+namespace ndntg {
+
+/**
+ * \brief Stand-in for the local forwarder, for testing the traffic tools without NFD.
+ *
+ * Applications connect to a Unix socket, exactly as they would connect to NFD. Prefixes
+ * registered through the rib/register command are routed to the registering application,
+ * and Data coming back are returned along a minimal pending Interest table. Interests that
+ * match no registered prefix are answered directly, either with a Data of a fixed size or,
+ * if so configured, with a Nack. There is no content store, no Interest aggregation, and no
+ * loop detection.
+ */
+class NdnTrafficEcho : boost::noncopyable
+{
+public:
+  explicit
+  NdnTrafficEcho(std::string socketPath)
+    : m_socketPath(std::move(socketPath))
+  {
+  }
+
+  void
+  setPayloadSize(std::size_t size)
+  {
+    m_payloadSize = size;
+  }
+
+  void
+  setNackUnrouted()
+  {
+    m_wantNackUnrouted = true;
+  }
+
+  void
+  setTimestampFormat(std::string format)
+  {
+    m_timestampFormat = std::move(format);
+  }
+
+  void
+  setQuietLogging()
+  {
+    m_wantQuiet = true;
+  }
+
+  int
+  run()
+  {
+    m_logger.initialize(std::to_string(ndn::random::generateWord32()), m_timestampFormat);
+
+    try {
+      std::error_code ec;
+      if (std::filesystem::is_socket(m_socketPath, ec)) {
+        std::filesystem::remove(m_socketPath, ec);
+      }
+      boost::asio::local::stream_protocol::endpoint endpoint(m_socketPath);
+      m_acceptor.open(endpoint.protocol());
+      m_acceptor.bind(endpoint);
+      m_acceptor.listen();
+    }
+    catch (const boost::system::system_error& e) {
+      m_logger.log("ERROR: Unable to listen on " + m_socketPath + ": " + e.what(), false, true);
+      return 2;
+    }
+
+    m_echoContent = ndn::makeBinaryBlock(ndn::tlv::Content, std::vector<uint8_t>(m_payloadSize));
+
+    m_signalSet.async_wait([this] (const boost::system::error_code& ec, int) {
+      if (!ec) {
+        stop();
+      }
+    });
+    accept();
+    scheduleExpiry();
+    m_logger.log("Listening on " + m_socketPath, true, true);
+
+    m_io.run();
+    return 0;
+  }
+
+private:
+  struct PendingInterest
+  {
+    ndn::Interest interest;
+    uint64_t downstream;
+    std::chrono::steady_clock::time_point expiry;
+  };
+
+  void
+  accept()
+  {
+    m_acceptor.async_accept([this] (const boost::system::error_code& ec,
+                                    boost::asio::local::stream_protocol::socket socket) {
+      if (ec == boost::asio::error::operation_aborted) {
+        return;
+      }
+      if (!ec) {
+        auto id = ++m_lastConnectionId;
+        auto transport = std::make_shared<BatchingTransport>(std::move(socket));
+        transport->setCloseHandler([this, id] { onDisconnected(id); });
+        transport->connect(m_io, [this, id] (const ndn::Block& wire) { onReceive(id, wire); });
+        transport->resume();
+        m_connections.emplace(id, std::move(transport));
+        m_nConnections++;
+        if (!m_wantQuiet) {
+          m_logger.log("Application #" + std::to_string(id) + " connected", true, false);
+        }
+      }
+      accept();
+    });
+  }
+
+  void
+  onDisconnected(uint64_t id)
+  {
+    m_connections.erase(id);
+    for (auto it = m_routes.begin(); it != m_routes.end();) {
+      if (it->second == id) {
+        it = m_routes.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+    if (!m_wantQuiet) {
+      m_logger.log("Application #" + std::to_string(id) + " disconnected", true, false);
+    }
+  }
+
+  void
+  send(uint64_t id, const ndn::Block& wire)
+  {
+    auto it = m_connections.find(id);
+    if (it != m_connections.end()) {
+      it->second->send(wire);
+    }
+  }
+
+  void
+  onReceive(uint64_t id, const ndn::Block& wire)
+  {
+    try {
+      auto packet = decodeNetworkPacket(wire);
+      switch (packet.wire.isValid() ? packet.wire.type() : 0) {
+        case ndn::tlv::Interest:
+          if (packet.nackHeader) {
+            ndn::lp::Nack nack{ndn::Interest(packet.wire)};
+            nack.setHeader(*packet.nackHeader);
+            onNack(nack);
+          }
+          else {
+            onInterest(id, ndn::Interest(packet.wire));
+          }
+          break;
+        case ndn::tlv::Data:
+          onData(ndn::Data(packet.wire));
+          break;
+      }
+    }
+    catch (const ndn::tlv::Error& e) {
+      m_logger.log("WARNING: Dropping malformed packet from application #" + std::to_string(id) +
+                   ": " + e.what(), true, false);
+    }
+  }
+
+  void
+  onInterest(uint64_t id, const ndn::Interest& interest)
+  {
+    static const ndn::Name managementPrefix("/localhost/nfd");
+
+    const auto& name = interest.getName();
+    if (name.size() > 4 && managementPrefix.isPrefixOf(name)) {
+      onCommand(id, interest);
+      return;
+    }
+    m_nInterests++;
+
+    // longest prefix match; there are typically very few routes
+    const ndn::Name* bestPrefix = nullptr;
+    uint64_t upstream = 0;
+    for (const auto& [prefix, face] : m_routes) {
+      if (face != id && prefix.isPrefixOf(name) && (!bestPrefix || prefix.size() > bestPrefix->size())) {
+        bestPrefix = &prefix;
+        upstream = face;
+      }
+    }
+
+    if (bestPrefix) {
+      m_pit[hashName(name)].push_back({interest, id, std::chrono::steady_clock::now() + interest.getInterestLifetime()});
+      m_nForwarded++;
+      send(upstream, interest.wireEncode());
+    }
+    else if (m_wantNackUnrouted) {
+      ndn::lp::Nack nack(interest);
+      nack.setReason(ndn::lp::NackReason::NO_ROUTE);
+      m_nNacked++;
+      send(id, encodeNack(nack));
+    }
+    else {
+      ndn::Data data(name);
+      data.setContent(m_echoContent);
+      m_keyChain.sign(data, ndn::security::signingWithSha256());
+      m_nEchoed++;
+      send(id, data.wireEncode());
+    }
+  }
+
+  void
+  onCommand(uint64_t id, const ndn::Interest& interest)
+  {
+    const auto& name = interest.getName();
+    m_nCommands++;
+
+    ndn::mgmt::ControlResponse response;
+    try {
+      ndn::nfd::ControlParameters parameters(name[4].blockFromValue());
+      auto command = name[2].toUri() + "/" + name[3].toUri();
+      if (command == "rib/register" && parameters.hasName()) {
+        m_routes[parameters.getName()] = id;
+        response = ndn::mgmt::ControlResponse(200, "OK").setBody(parameters.wireEncode());
+        if (!m_wantQuiet) {
+          m_logger.log("Application #" + std::to_string(id) + " registered " + parameters.getName().toUri(),
+                       true, false);
+        }
+      }
+      else if (command == "rib/unregister" && parameters.hasName()) {
+        auto route = m_routes.find(parameters.getName());
+        if (route != m_routes.end() && route->second == id) {
+          m_routes.erase(route);
+        }
+        response = ndn::mgmt::ControlResponse(200, "OK").setBody(parameters.wireEncode());
+      }
+      else {
+        response = ndn::mgmt::ControlResponse(501, "Unsupported command");
+      }
+    }
+    catch (const ndn::tlv::Error&) {
+      response = ndn::mgmt::ControlResponse(400, "Malformed command");
+    }
+
+    ndn::Data data(name);
+    data.setContent(response.wireEncode());
+    m_keyChain.sign(data, ndn::security::signingWithSha256());
+    send(id, data.wireEncode());
+  }
+
+  void
+  onData(const ndn::Data& data)
+  {
+    bool isSolicited = false;
+    for (auto hash : hashNamePrefixes(data.getName())) {
+      auto bucket = m_pit.find(hash);
+      if (bucket == m_pit.end()) {
+        continue;
+      }
+      auto& entries = bucket->second;
+      for (auto it = entries.begin(); it != entries.end();) {
+        if (it->interest.matchesData(data)) {
+          isSolicited = true;
+          m_nDataReturned++;
+          send(it->downstream, data.wireEncode());
+          it = entries.erase(it);
+        }
+        else {
+          ++it;
+        }
+      }
+      if (entries.empty()) {
+        m_pit.erase(bucket);
+      }
+    }
+
+    if (!isSolicited) {
+      m_nUnsolicitedData++;
+    }
+  }
+
+  void
+  onNack(const ndn::lp::Nack& nack)
+  {
+    const auto& interest = nack.getInterest();
+    auto bucket = m_pit.find(hashName(interest.getName()));
+    if (bucket == m_pit.end()) {
+      return;
+    }
+    auto& entries = bucket->second;
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+      if (it->interest.getNonce() == interest.getNonce() && it->interest.getName() == interest.getName()) {
+        m_nNacked++;
+        send(it->downstream, encodeNack(nack));
+        entries.erase(it);
+        break;
+      }
+    }
+    if (entries.empty()) {
+      m_pit.erase(bucket);
+    }
+  }
+
+  void
+  scheduleExpiry()
+  {
+    m_expiryTimer.expires_after(100ms);
+    m_expiryTimer.async_wait([this] (const boost::system::error_code& ec) {
+      if (ec) {
+        return;
+      }
+      auto now = std::chrono::steady_clock::now();
+      for (auto bucket = m_pit.begin(); bucket != m_pit.end();) {
+        auto& entries = bucket->second;
+        auto nEntries = entries.size();
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [now] (const auto& entry) { return entry.expiry <= now; }),
+                      entries.end());
+        m_nUnsatisfied += nEntries - entries.size();
+        bucket = entries.empty() ? m_pit.erase(bucket) : std::next(bucket);
+      }
+      scheduleExpiry();
+    });
+  }
+
+  void
+  logStatistics()
+  {
+    using std::to_string;
+
+    m_logger.log("\n\n== Forwarder Report ==\n", false, true);
+    m_logger.log("Applications Connected      = " + to_string(m_nConnections), false, true);
+    m_logger.log("Management Commands         = " + to_string(m_nCommands), false, true);
+    m_logger.log("Total Interests Received    = " + to_string(m_nInterests), false, true);
+    m_logger.log("Interests Forwarded         = " + to_string(m_nForwarded), false, true);
+    m_logger.log("Interests Echoed            = " + to_string(m_nEchoed), false, true);
+    m_logger.log("Nacks Sent                  = " + to_string(m_nNacked), false, true);
+    m_logger.log("Data Returned               = " + to_string(m_nDataReturned), false, true);
+    m_logger.log("Unsolicited Data            = " + to_string(m_nUnsolicitedData), false, true);
+    m_logger.log("Unsatisfied Interests       = " + to_string(m_nUnsatisfied) + "\n", false, true);
+  }
+
+  void
+  stop()
+  {
+    logStatistics();
+
+    boost::system::error_code ec;
+    m_acceptor.close(ec);
+    std::error_code fsEc;
+    std::filesystem::remove(m_socketPath, fsEc);
+    for (auto& [id, transport] : m_connections) {
+      transport->close();
+    }
+    m_expiryTimer.cancel();
+    m_io.stop();
+  }
+
+private:
+  Logger m_logger{"NdnTrafficEcho"};
+  boost::asio::io_context m_io;
+  boost::asio::signal_set m_signalSet{m_io, SIGINT, SIGTERM};
+  boost::asio::steady_timer m_expiryTimer{m_io};
+  boost::asio::local::stream_protocol::acceptor m_acceptor{m_io};
+  ndn::KeyChain m_keyChain;
+
+  const std::string m_socketPath;
+  std::string m_timestampFormat;
+  std::size_t m_payloadSize = 1024;
+  ndn::Block m_echoContent;
+
+  std::map<uint64_t, std::shared_ptr<BatchingTransport>> m_connections;
+  uint64_t m_lastConnectionId = 0;
+  std::map<ndn::Name, uint64_t> m_routes;
+  std::unordered_map<uint64_t, std::vector<PendingInterest>> m_pit; ///< by name hash
+
+  uint64_t m_nConnections = 0;
+  uint64_t m_nCommands = 0;
+  uint64_t m_nInterests = 0;
+  uint64_t m_nForwarded = 0;
+  uint64_t m_nEchoed = 0;
+  uint64_t m_nNacked = 0;
+  uint64_t m_nDataReturned = 0;
+  uint64_t m_nUnsolicitedData = 0;
+  uint64_t m_nUnsatisfied = 0;
+
+  bool m_wantNackUnrouted = false;
+  bool m_wantQuiet = false;
+};
+
+} // namespace ndntg
+
+namespace po = boost::program_options;
+
+static void
+usage(std::ostream& os, std::string_view programName, const po::options_description& desc)
+{
+  os << "Usage: " << programName << " [options] [Socket_Path]\n"
+     << "\n"
+     << "Stand in for the local forwarder when testing the traffic tools.\n"
+     << "Interests are routed to the applications that registered a matching prefix;\n"
+     << "the other Interests are answered directly. Socket_Path defaults to the socket\n"
+     << "given by NDN_CLIENT_TRANSPORT, or to the default socket of NFD.\n"
+     << "Set the environment variable NDN_TRAFFIC_LOGFOLDER to redirect output to a log file.\n"
+     << "\n"
+     << desc;
+}
+
+int
+main(int argc, char* argv[])
+{
+  std::string socketPath;
+  std::string timestampFormat;
+
+  po::options_description visibleOptions("Options");
+  visibleOptions.add_options()
+    ("help,h",         "print this help message and exit")
+    ("payload-size,s", po::value<std::size_t>()->default_value(1024),
+                       "content size in bytes of the Data answering unrouted Interests")
+    ("nack-unrouted",  po::bool_switch(), "answer unrouted Interests with a Nack instead of Data")
+    ("timestamp-format,t", po::value<std::string>(&timestampFormat), "format string for timestamp output")
+    ("quiet,q",        po::bool_switch(), "turn off logging of connections and prefix registrations")
+    ;
+
+  po::options_description hiddenOptions;
+  hiddenOptions.add_options()
+    ("socket-path", po::value<std::string>(&socketPath))
+    ;
+
+  po::positional_options_description posOptions;
+  posOptions.add("socket-path", -1);
+
+  po::options_description allOptions;
+  allOptions.add(visibleOptions).add(hiddenOptions);
+
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv).options(allOptions).positional(posOptions).run(), vm);
+    po::notify(vm);
+  }
+  catch (const po::error& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 2;
+  }
+  catch (const boost::bad_any_cast& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 2;
+  }
+
+  if (vm.count("help") > 0) {
+    usage(std::cout, argv[0], visibleOptions);
+    return 0;
+  }
+
+  if (socketPath.empty()) {
+    const char* uri = std::getenv("NDN_CLIENT_TRANSPORT");
+    socketPath = ndn::UnixTransport::getSocketNameFromUri(uri ? uri : "");
+  }
+
+  ndntg::NdnTrafficEcho echo(std::move(socketPath));
+
+  auto payloadSize = vm["payload-size"].as<std::size_t>();
+  if (payloadSize > ndn::MAX_NDN_PACKET_SIZE) {
+    std::cerr << "ERROR: the argument for option '--payload-size' cannot exceed " << ndn::MAX_NDN_PACKET_SIZE << "\n";
+    return 2;
+  }
+  echo.setPayloadSize(payloadSize);
+
+  if (vm["nack-unrouted"].as<bool>()) {
+    echo.setNackUnrouted();
+  }
+
+  if (!timestampFormat.empty()) {
+    echo.setTimestampFormat(std::move(timestampFormat));
+  }
+
+  if (vm["quiet"].as<bool>()) {
+    echo.setQuietLogging();
+  }
+
+  return echo.run();
+}
@@ -18,25 +18,44 @@
  * Author: Jerald Paul Abraham <jeraldabraham@email.arizona.edu>
  */
 
+#include "batching-transport.hpp"
+#include "delay-distribution.hpp"
+#include "execution-mode.hpp"
+#include "histogram.hpp"
+#include "memory-usage.hpp"
+#include "metrics.hpp"
+#include "name-template.hpp"
+#include "random.hpp"
+#include "raw-face.hpp"
+#include "run-periods.hpp"
 #include "util.hpp"
 
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/lp/nack.hpp>
 #include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/security/signing-helpers.hpp>
 #include <ndn-cxx/security/signing-info.hpp>
 #include <ndn-cxx/util/random.hpp>
 #include <ndn-cxx/util/time.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <deque>
+#include <functional>
 #include <limits>
+#include <map>
 #include <optional>
+#include <queue>
 #include <sstream>
 #include <thread>
 #include <vector>
 
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/signal_set.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/core/noncopyable.hpp>
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/parsers.hpp>
@@ -52,6 +71,15 @@ using namespace std::string_literals;
 class NdnTrafficServer : boost::noncopyable
 {
 public:
+  /**
+   * \brief What happens to an Interest that cannot be admitted to the work queue.
+   */
+  enum class OverloadPolicy {
+    DROP_TAIL,  ///< drop Interests that arrive while the queue is full
+    DROP_STALE, ///< like DROP_TAIL, but first drop the queued Interests whose lifetime has expired
+    NACK,       ///< answer Interests that arrive while the queue is full with an application Nack
+  };
+
   explicit
   NdnTrafficServer(std::string configFile)
     : m_configurationFile(std::move(configFile))
@@ -71,31 +99,125 @@ public:
     m_contentDelay = delay;
   }
 
+  void
+  setRunPeriods(const RunPeriods& periods)
+  {
+    m_runPeriods = periods;
+  }
+
+  /**
+   * \brief Once interrupted, keeps sending the queued and delayed responses for at most \p period.
+   */
+  void
+  setDrainPeriod(std::chrono::milliseconds period)
+  {
+    BOOST_ASSERT(period >= 0ms);
+    m_drainPeriod = period;
+  }
+
   void
   setTimestampFormat(std::string format)
   {
     m_timestampFormat = std::move(format);
   }
 
+  void
+  setCoarseTimestamps()
+  {
+    m_logger.setCoarseTimestamps();
+  }
+
   void
   setQuietLogging()
   {
     m_wantQuiet = true;
   }
 
+  void
+  setMetricsSocket(std::string path)
+  {
+    m_metricsSocket = std::move(path);
+  }
+
+  void
+  setBatchedWrites()
+  {
+    m_wantBatchedWrites = true;
+  }
+
+  void
+  setRawEngine()
+  {
+    m_wantRawEngine = true;
+  }
+
+  void
+  setExecutionMode(ExecutionMode mode)
+  {
+    m_executionMode = std::move(mode);
+  }
+
+  /**
+   * \brief Queues received Interests and sheds load beyond \p capacity according to \p policy.
+   *
+   * By default, each Interest is answered as soon as it is received, so under overload the
+   * backlog grows without bounds in the socket buffers and stale Interests are answered.
+   */
+  void
+  setWorkQueue(std::size_t capacity, OverloadPolicy policy)
+  {
+    BOOST_ASSERT(capacity > 0);
+    m_queueCapacity = capacity;
+    m_overloadPolicy = policy;
+  }
+
+  void
+  setReportInterval(std::chrono::milliseconds interval)
+  {
+    BOOST_ASSERT(interval > 0ms);
+    m_reportInterval = interval;
+  }
+
   int
   run()
   {
     m_logger.initialize(std::to_string(ndn::random::generateWord32()), m_timestampFormat);
 
+    // before anything is allocated for the traffic, so that it lands on the right NUMA node
+    try {
+      m_executionMode.apply();
+    }
+    catch (const std::system_error& e) {
+      m_logger.log("ERROR: Unable to set execution mode: "s + e.what(), false, true);
+      return 2;
+    }
+
+    if (m_wantRawEngine) {
+      m_rawFace.emplace(m_io, &m_keyChain);
+      m_batchingTransport = m_rawFace->getTransport();
+    }
+    else {
+      if (m_wantBatchedWrites) {
+        m_batchingTransport = BatchingTransport::create();
+      }
+      m_face.emplace(m_batchingTransport, m_io);
+    }
+
     if (!readConfigurationFile(m_configurationFile, m_trafficPatterns, m_logger)) {
       return 2;
     }
 
+    if (m_trafficPatterns.empty()) {
+      m_logger.log("ERROR: No traffic pattern in configuration file: " + m_configurationFile, false, true);
+      return 2;
+    }
+
     if (!checkTrafficPatternCorrectness()) {
-      m_logger.log("ERROR: Traffic configuration provided is not proper", false, true);
       return 2;
     }
+    m_processingStatistics.resize(m_trafficPatterns.size());
+    m_warmupStatistics.resize(m_trafficPatterns.size());
+    m_cooldownStatistics.resize(m_trafficPatterns.size());
 
     m_logger.log("Traffic configuration file processing completed\n", true, false);
     for (std::size_t i = 0; i < m_trafficPatterns.size(); i++) {
@@ -109,23 +231,72 @@ public:
       return 0;
     }
 
-    m_signalSet.async_wait([this] (const boost::system::error_code&, int) {
-      if (m_nMaximumInterests && m_nInterestsReceived < *m_nMaximumInterests) {
-        m_hasError = true;
+    waitForSignal();
+
+    if (!m_metricsSocket.empty()) {
+      try {
+        m_metricsExporter.emplace(m_io, m_metricsSocket, [this] (auto& writer) { writeMetrics(writer); });
+        m_metricsExporter->start();
       }
-      stop();
-    });
+      catch (const boost::system::system_error& e) {
+        m_logger.log("ERROR: Unable to create metrics socket " + m_metricsSocket + ": " + e.what(),
+                     false, true);
+        return 2;
+      }
+    }
 
+    if (m_reportInterval) {
+      m_reportTimer.expires_after(*m_reportInterval);
+      scheduleProgressReport();
+    }
+
+    m_runPeriods.start(std::chrono::steady_clock::now());
+    if (auto duration = m_runPeriods.getDuration()) {
+      m_durationTimer.expires_after(*duration);
+      m_durationTimer.async_wait([this] (const boost::system::error_code& ec) {
+        if (!ec) {
+          startDrain("Run duration elapsed");
+        }
+      });
+    }
+
+    // a prefix is registered only once, even if the name families of several patterns start with it
+    std::map<ndn::Name, std::vector<std::size_t>> patternsByPrefix;
     for (std::size_t id = 0; id < m_trafficPatterns.size(); id++) {
-      m_registeredPrefixes.push_back(
-        m_face.setInterestFilter(m_trafficPatterns[id].m_name,
-                                 [this, id] (auto&&, const auto& interest) { onInterest(interest, id); },
-                                 nullptr,
-                                 [this, id] (auto&&, const auto& reason) { onRegisterFailed(reason, id); }));
+      patternsByPrefix[m_trafficPatterns[id].m_nameTemplate.getPrefix()].push_back(id);
+    }
+    for (auto& [prefix, ids] : patternsByPrefix) {
+      // the longest Name that matches wins
+      std::stable_sort(ids.begin(), ids.end(), [this] (auto lhs, auto rhs) {
+        return m_trafficPatterns[lhs].m_nameTemplate.size() > m_trafficPatterns[rhs].m_nameTemplate.size();
+      });
+      auto onInterest = [this, ids = ids] (auto&&, const auto& interest) { dispatchInterest(interest, ids); };
+      auto onFailure = [this, ids = ids] (auto&&, const auto& reason) {
+        for (auto id : ids) {
+          onRegisterFailed(reason, id);
+        }
+      };
+      if (m_rawFace) {
+        m_rawFace->setInterestFilter(prefix, onInterest, onFailure);
+      }
+      else {
+        m_registeredPrefixes.push_back(m_face->setInterestFilter(prefix, onInterest, nullptr, onFailure));
+      }
     }
 
     try {
-      m_face.processEvents();
+      if (m_rawFace) {
+        m_rawFace->processEvents(m_executionMode.wantBusyPoll);
+      }
+      else if (m_executionMode.wantBusyPoll) {
+        // a negative timeout polls once without blocking
+        while (!m_io.stopped()) {
+          m_face->processEvents(ndn::time::milliseconds(-1));
+        }
+      }
+      else {
+        m_face->processEvents();
+      }
       return m_hasError ? 1 : 0;
     }
     catch (const std::exception& e) {
@@ -147,9 +318,22 @@ private:
       if (!m_name.empty()) {
         os << "Name=" << m_name << ", ";
       }
+      if (m_nameTemplate.isTemplate()) {
+        os << "NameCount=" << m_nameTemplate.getMemberCount() << ", ";
+      }
       if (m_contentDelay >= 0ms) {
         os << "ContentDelay=" << m_contentDelay.count() << ", ";
       }
+      if (m_dropPercentage > 0.0) {
+        os << "DropPercentage=" << m_dropPercentage << ", ";
+      }
+      if (m_nackPercentage > 0.0) {
+        os << "NackPercentage=" << m_nackPercentage << ", ";
+        os << "NackReason=" << m_nackReason << ", ";
+      }
+      if (m_responseDelay) {
+        os << "ResponseDelay=" << m_responseDelay->toString() << ", ";
+      }
       if (m_freshnessPeriod >= 0_ms) {
         os << "FreshnessPeriod=" << m_freshnessPeriod.count() << ", ";
       }
@@ -168,60 +352,375 @@ private:
     }
 
     bool
-    parseConfigurationLine(const std::string& line, Logger& logger, int lineNumber)
+    parseConfigurationLine(std::string_view parameter, std::string_view value, Logger& logger, int lineNumber)
     {
-      std::string parameter, value;
-      if (!extractParameterAndValue(line, parameter, value)) {
-        logger.log("Line " + std::to_string(lineNumber) + " - Invalid syntax: " + line,
-                   false, true);
-        return false;
-      }
-
+      auto fail = [&] (const std::string& message) {
+        return reportConfigurationError(logger, lineNumber, message);
+      };
+      auto parseInteger = [&] (uint64_t& result, uint64_t maxValue) {
+        if (!parseNumber(value, result) || result > maxValue) {
+          return fail(std::string(parameter) + " must be an integer between 0 and " + std::to_string(maxValue));
+        }
+        return true;
+      };
+
+      uint64_t number = 0;
       if (parameter == "Name") {
+        try {
+          m_nameTemplate = NameTemplate(value);
+        }
+        catch (const std::exception& e) {
+          return fail("Invalid Name: "s + e.what());
+        }
         m_name = value;
       }
       else if (parameter == "ContentDelay") {
-        m_contentDelay = std::chrono::milliseconds(std::stoul(value));
+        if (!parseInteger(number, std::numeric_limits<uint32_t>::max())) {
+          return false;
+        }
+        m_contentDelay = std::chrono::milliseconds(number);
+      }
+      else if (parameter == "DropPercentage" || parameter == "NackPercentage") {
+        double percentage = 0.0;
+        if (!parseNumber(value, percentage) || percentage < 0.0 || percentage > 100.0) {
+          return fail(std::string(parameter) + " must be a number between 0 and 100");
+        }
+        (parameter == "DropPercentage" ? m_dropPercentage : m_nackPercentage) = percentage;
+      }
+      else if (parameter == "NackReason") {
+        if (value == "Congestion") {
+          m_nackReason = ndn::lp::NackReason::CONGESTION;
+        }
+        else if (value == "Duplicate") {
+          m_nackReason = ndn::lp::NackReason::DUPLICATE;
+        }
+        else if (value == "NoRoute") {
+          m_nackReason = ndn::lp::NackReason::NO_ROUTE;
+        }
+        else {
+          return fail("NackReason must be 'Congestion', 'Duplicate', or 'NoRoute'");
+        }
+      }
+      else if (parameter == "ResponseDelay") {
+        try {
+          m_responseDelay.emplace(value);
+        }
+        catch (const std::invalid_argument& e) {
+          return fail("Invalid ResponseDelay: "s + e.what());
+        }
       }
       else if (parameter == "FreshnessPeriod") {
-        m_freshnessPeriod = ndn::time::milliseconds(std::stoul(value));
+        if (!parseInteger(number, std::numeric_limits<uint32_t>::max())) {
+          return false;
+        }
+        m_freshnessPeriod = ndn::time::milliseconds(number);
       }
       else if (parameter == "ContentType") {
-        m_contentType = std::stoul(value);
+        if (!parseInteger(number, std::numeric_limits<uint32_t>::max())) {
+          return false;
+        }
+        m_contentType = static_cast<uint32_t>(number);
       }
       else if (parameter == "ContentBytes") {
-        m_contentLength = std::stoul(value);
+        if (!parseInteger(number, ndn::MAX_NDN_PACKET_SIZE)) {
+          return false;
+        }
+        m_contentLength = number;
       }
       else if (parameter == "Content") {
         m_content = value;
+        m_contentBlock = ndn::makeStringBlock(ndn::tlv::Content, m_content);
       }
       else if (parameter == "SigningInfo") {
-        m_signingInfo = ndn::security::SigningInfo(value);
+        try {
+          m_signingInfo = ndn::security::SigningInfo(value);
+        }
+        catch (const std::exception& e) {
+          return fail("Invalid SigningInfo: "s + e.what());
+        }
       }
       else {
-        logger.log("Line " + std::to_string(lineNumber) + " - Ignoring unknown parameter: " + parameter,
-                   false, true);
+        logger.log("Line " + std::to_string(lineNumber) + " - Ignoring unknown parameter: " +
+                   std::string(parameter), false, true);
       }
       return true;
     }
 
     bool
-    checkTrafficDetailCorrectness() const
+    hasInjectedBehavior() const
     {
+      return m_dropPercentage > 0.0 || m_nackPercentage > 0.0 || m_responseDelay.has_value();
+    }
+
+    bool
+    checkTrafficDetailCorrectness(Logger& logger, int lineNumber) const
+    {
+      if (m_name.empty()) {
+        return reportConfigurationError(logger, lineNumber, "Traffic pattern has no Name");
+      }
+      if (m_dropPercentage + m_nackPercentage > 100.0) {
+        return reportConfigurationError(logger, lineNumber, "Sum of DropPercentage and NackPercentage exceeds 100");
+      }
       return true;
     }
 
   public:
     std::string m_name;
+    NameTemplate m_nameTemplate;
     std::chrono::milliseconds m_contentDelay{-1};
+    double m_dropPercentage = 0.0;
+    double m_nackPercentage = 0.0;
+    ndn::lp::NackReason m_nackReason = ndn::lp::NackReason::NO_ROUTE;
+    /// delay between answering an Interest and sending its Data, which does not block the server
+    std::optional<DelayDistribution> m_responseDelay;
     ndn::time::milliseconds m_freshnessPeriod{-1};
     std::optional<uint32_t> m_contentType;
     std::optional<std::size_t> m_contentLength;
     std::string m_content;
+    /// encoded once from m_content, so that fixed content is not re-encoded for every Data
+    std::optional<ndn::Block> m_contentBlock;
     ndn::security::SigningInfo m_signingInfo;
+    /// Interests answered in all run periods, which numbers them in the log
+    uint64_t m_nInterestsAnswered = 0;
+  };
+
+  struct DelayedResponse
+  {
+    std::chrono::steady_clock::time_point dueTime;
+    uint64_t sequence; ///< keeps responses that are due at the same time in order
+    std::size_t patternId;
+    std::chrono::steady_clock::time_point scheduledTime;
+    ndn::Data data;
+
+    friend bool
+    operator>(const DelayedResponse& lhs, const DelayedResponse& rhs)
+    {
+      return std::tie(lhs.dueTime, lhs.sequence) > std::tie(rhs.dueTime, rhs.sequence);
+    }
+  };
+
+  struct QueuedInterest
+  {
+    ndn::Interest interest;
+    std::size_t patternId;
+    std::chrono::steady_clock::time_point arrivalTime;
+  };
+
+  /**
+   * \brief Time spent on the Interests of one traffic pattern, broken down by processing phase.
+   *
+   * The queueing delay is the time from the completion of the read that delivered an Interest
+   * until the server started to process it, e.g., behind the other Interests of that read or
+   * behind a ContentDelay. It is only known when the batching transport or the work queue is
+   * in use; with the default transport, Interests entering the work queue are timestamped on
+   * arrival.
+   */
+  class alignas(64) ProcessingStatistics
+  {
+  public:
+    void
+    merge(const ProcessingStatistics& other)
+    {
+      m_queueingDelay.merge(other.m_queueingDelay);
+      m_constructionTime.merge(other.m_constructionTime);
+      m_contentTime.merge(other.m_contentTime);
+      m_signingTime.merge(other.m_signingTime);
+      m_delayTime.merge(other.m_delayTime);
+      m_responseDelay.merge(other.m_responseDelay);
+      m_putTime.merge(other.m_putTime);
+      m_processingTime.merge(other.m_processingTime);
+      m_nInterestsReceived += other.m_nInterestsReceived;
+      m_nInterestsDropped += other.m_nInterestsDropped;
+      m_nInterestsExpired += other.m_nInterestsExpired;
+      m_nInterestsNacked += other.m_nInterestsNacked;
+      m_nDropsInjected += other.m_nDropsInjected;
+      m_nNacksInjected += other.m_nNacksInjected;
+    }
+
+  public:
+    Histogram m_queueingDelay;
+    Histogram m_constructionTime; ///< creating the Data and setting its MetaInfo
+    Histogram m_contentTime;      ///< generating and encoding the Content
+    Histogram m_signingTime;
+    Histogram m_delayTime;        ///< waiting for the configured ContentDelay
+    Histogram m_responseDelay;    ///< realized ResponseDelay, including the lateness of the timer
+    Histogram m_putTime;          ///< handing the Data to the face
+    Histogram m_processingTime;   ///< all of the above and logging, excluding queueing and ResponseDelay
     uint64_t m_nInterestsReceived = 0;
+    uint64_t m_nInterestsReported = 0; ///< at the time of the last progress report
+    uint64_t m_nInterestsDropped = 0;  ///< because the work queue was full
+    uint64_t m_nInterestsExpired = 0;  ///< because their lifetime expired in the work queue
+    uint64_t m_nInterestsNacked = 0;   ///< because the work queue was full
+    uint64_t m_nDropsInjected = 0;     ///< as per DropPercentage
+    uint64_t m_nNacksInjected = 0;     ///< as per NackPercentage
   };
 
+  bool
+  hasQueueingDelay() const
+  {
+    return m_batchingTransport != nullptr || m_queueCapacity.has_value();
+  }
+
+  static std::string
+  formatMilliseconds(std::chrono::nanoseconds duration)
+  {
+    return std::to_string(duration.count() / 1e6) + "ms";
+  }
+
+  /**
+   * \brief Returns the statistics of pattern \p patternId for the Interests handled at \p time;
+   *        those handled during the warm-up or the cool-down are accounted apart.
+   */
+  ProcessingStatistics&
+  getProcessingStatistics(std::size_t patternId, std::chrono::steady_clock::time_point time)
+  {
+    switch (m_runPeriods.getPeriod(time)) {
+      case RunPeriods::Period::WARMUP:
+        return m_warmupStatistics[patternId];
+      case RunPeriods::Period::COOLDOWN:
+        return m_cooldownStatistics[patternId];
+      case RunPeriods::Period::MEASUREMENT:
+        break;
+    }
+    return m_processingStatistics[patternId];
+  }
+
+  static ProcessingStatistics
+  mergeStatistics(const std::vector<ProcessingStatistics>& patternStatistics)
+  {
+    ProcessingStatistics total;
+    for (const auto& stats : patternStatistics) {
+      total.merge(stats);
+    }
+    return total;
+  }
+
+  /**
+   * \brief Logs the Interests handled during the warm-up or the cool-down, which are excluded
+   *        from all other statistics.
+   */
+  void
+  logRampStatistics(RunPeriods::Period period, const std::vector<ProcessingStatistics>& patternStatistics)
+  {
+    auto stats = mergeStatistics(patternStatistics);
+    m_logger.log(RunPeriods::toString(period) + " Period (excluded from the statistics above)", false, true);
+    m_logger.log("Total Interests Received    = " + std::to_string(stats.m_nInterestsReceived), false, true);
+    if (m_queueCapacity) {
+      logShedInterests(stats);
+    }
+    if (std::any_of(m_trafficPatterns.begin(), m_trafficPatterns.end(),
+                    [] (const auto& pattern) { return pattern.hasInjectedBehavior(); })) {
+      m_logger.log("Injected Drops              = " + std::to_string(stats.m_nDropsInjected), false, true);
+      m_logger.log("Injected Nacks              = " + std::to_string(stats.m_nNacksInjected), false, true);
+    }
+    m_logger.log("Median Processing Time      = " + formatMilliseconds(stats.m_processingTime.getPercentile(50)),
+                 false, true);
+    m_logger.log("99th Pct Processing Time    = " + formatMilliseconds(stats.m_processingTime.getPercentile(99)) +
+                 "\n", false, true);
+  }
+
+  void
+  logProcessingStatistics(const ProcessingStatistics& stats)
+  {
+    if (hasQueueingDelay()) {
+      m_logger.log("Median Queueing Delay       = " + formatMilliseconds(stats.m_queueingDelay.getPercentile(50)),
+                   false, true);
+      m_logger.log("99th Pct Queueing Delay     = " + formatMilliseconds(stats.m_queueingDelay.getPercentile(99)),
+                   false, true);
+    }
+    m_logger.log("Median Processing Time      = " + formatMilliseconds(stats.m_processingTime.getPercentile(50)),
+                 false, true);
+    m_logger.log("99th Pct Processing Time    = " + formatMilliseconds(stats.m_processingTime.getPercentile(99)),
+                 false, true);
+    m_logger.log("Maximum Processing Time     = " + formatMilliseconds(stats.m_processingTime.getMax()),
+                 false, true);
+    m_logger.log("Avg Data Construction Time  = " + formatMilliseconds(stats.m_constructionTime.getMean()),
+                 false, true);
+    m_logger.log("Avg Content Generation Time = " + formatMilliseconds(stats.m_contentTime.getMean()),
+                 false, true);
+    m_logger.log("Avg Signing Time            = " + formatMilliseconds(stats.m_signingTime.getMean()),
+                 false, true);
+    m_logger.log("Avg Content Delay           = " + formatMilliseconds(stats.m_delayTime.getMean()),
+                 false, true);
+    m_logger.log("Avg Put Time                = " + formatMilliseconds(stats.m_putTime.getMean()) + "\n",
+                 false, true);
+  }
+
+  /**
+   * \brief Logs how often the configured drops and Nacks actually occurred, and the realized
+   *        distribution of the ResponseDelay.
+   */
+  void
+  logInjectedBehavior(const ProcessingStatistics& stats)
+  {
+    using std::to_string;
+
+    auto nHandled = stats.m_nInterestsReceived + stats.m_nDropsInjected + stats.m_nNacksInjected;
+    auto percentage = [nHandled] (uint64_t count) {
+      return to_string(nHandled > 0 ? count * 100.0 / nHandled : 0.0) + "%";
+    };
+    m_logger.log("Injected Drops              = " + to_string(stats.m_nDropsInjected) +
+                 " (" + percentage(stats.m_nDropsInjected) + ")", false, true);
+    m_logger.log("Injected Nacks              = " + to_string(stats.m_nNacksInjected) +
+                 " (" + percentage(stats.m_nNacksInjected) + ")", false, true);
+    const auto& delay = stats.m_responseDelay;
+    m_logger.log("Delayed Responses           = " + to_string(delay.getCount()), false, true);
+    m_logger.log("Average Response Delay      = " + formatMilliseconds(delay.getMean()), false, true);
+    m_logger.log("Median Response Delay       = " + formatMilliseconds(delay.getPercentile(50)), false, true);
+    m_logger.log("99th Pct Response Delay     = " + formatMilliseconds(delay.getPercentile(99)), false, true);
+    m_logger.log("Maximum Response Delay      = " + formatMilliseconds(delay.getMax()), false, true);
+  }
+
+  void
+  logShedInterests(const ProcessingStatistics& stats)
+  {
+    using std::to_string;
+
+    m_logger.log("Interests Dropped (Full)    = " + to_string(stats.m_nInterestsDropped), false, true);
+    m_logger.log("Interests Dropped (Expired) = " + to_string(stats.m_nInterestsExpired), false, true);
+    m_logger.log("Interests Nack'ed (Full)    = " + to_string(stats.m_nInterestsNacked), false, true);
+  }
+
+  void
+  scheduleProgressReport()
+  {
+    m_reportTimer.async_wait([this] (const boost::system::error_code& ec) {
+      if (ec) {
+        return;
+      }
+      logProgress();
+      m_reportTimer.expires_at(m_reportTimer.expiry() + *m_reportInterval);
+      scheduleProgressReport();
+    });
+  }
+
+  void
+  logProgress()
+  {
+    using std::to_string;
+
+    auto intervalSeconds = std::chrono::duration<double>(*m_reportInterval).count();
+    auto now = std::chrono::steady_clock::now();
+    for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
+      // the progress of the current run period, whose first report may cover less than an interval
+      auto& stats = getProcessingStatistics(patternId, now);
+      double rate = (stats.m_nInterestsReceived - stats.m_nInterestsReported) / intervalSeconds;
+      stats.m_nInterestsReported = stats.m_nInterestsReceived;
+
+      auto line = "Progress - PatternType=" + to_string(patternId + 1) +
+                  ", Period=" + RunPeriods::toString(m_runPeriods.getPeriod(now)) +
+                  ", Interests=" + to_string(stats.m_nInterestsReceived) +
+                  ", Rate=" + to_string(rate) + "/s" +
+                  ", MedianProcessing=" + formatMilliseconds(stats.m_processingTime.getPercentile(50)) +
+                  ", 99thPctProcessing=" + formatMilliseconds(stats.m_processingTime.getPercentile(99));
+      if (hasQueueingDelay()) {
+        line += ", 99thPctQueueing=" + formatMilliseconds(stats.m_queueingDelay.getPercentile(99));
+      }
+      m_logger.log(line, true, true);
+    }
+    m_logger.log("Memory - " + MemoryUsage::read().toString(), true, true);
+  }
+
   void
   logStatistics()
   {
@@ -229,46 +728,301 @@ private:
 
     m_logger.log("\n\n== Traffic Report ==\n", false, true);
     m_logger.log("Total Traffic Pattern Types = " + to_string(m_trafficPatterns.size()), false, true);
-    m_logger.log("Total Interests Received    = " + to_string(m_nInterestsReceived) + "\n", false, true);
+    auto total = mergeStatistics(m_processingStatistics);
+    m_logger.log("Total Interests Received    = " + to_string(total.m_nInterestsReceived), false, true);
+    if (m_queueCapacity) {
+      m_logger.log("Work Queue Capacity         = " + to_string(*m_queueCapacity), false, true);
+      m_logger.log("Maximum Work Queue Length   = " + to_string(m_maxQueueLength), false, true);
+      logShedInterests(total);
+    }
+    if (std::any_of(m_trafficPatterns.begin(), m_trafficPatterns.end(),
+                    [] (const auto& pattern) { return pattern.hasInjectedBehavior(); })) {
+      logInjectedBehavior(total);
+    }
+    logProcessingStatistics(total);
+    if (m_runPeriods.hasRamps()) {
+      m_runPeriods.log(m_logger);
+      logRampStatistics(RunPeriods::Period::WARMUP, m_warmupStatistics);
+      logRampStatistics(RunPeriods::Period::COOLDOWN, m_cooldownStatistics);
+    }
 
     for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
       const auto& pattern = m_trafficPatterns[patternId];
 
       m_logger.log("Traffic Pattern Type #" + to_string(patternId + 1), false, true);
       pattern.printTrafficConfiguration(m_logger);
-      m_logger.log("Total Interests Received    = " +
-                   to_string(pattern.m_nInterestsReceived) + "\n", false, true);
+      if (patternId < m_processingStatistics.size()) {
+        const auto& stats = m_processingStatistics[patternId];
+        m_logger.log("Total Interests Received    = " + to_string(stats.m_nInterestsReceived), false, true);
+        if (m_queueCapacity) {
+          logShedInterests(stats);
+        }
+        if (pattern.hasInjectedBehavior()) {
+          logInjectedBehavior(stats);
+        }
+        logProcessingStatistics(stats);
+      }
+    }
+
+    if (m_batchingTransport) {
+      logTransportStatistics(m_logger, m_batchingTransport->getCounters());
+    }
+    m_executionMode.log(m_logger);
+    logMemoryUsage(m_logger, MemoryUsage::read());
+    if (auto seed = random::getSeed()) {
+      m_logger.log("Random Seed                 = " + std::to_string(*seed) + "\n", false, true);
+    }
+  }
+
+  void
+  writeMetrics(MetricsWriter& writer) const
+  {
+    static const std::string prefix = "ndntg_server_";
+
+    writer.writeHeader(prefix + "interests_received_total", "counter", "Interests answered with Data");
+    for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
+      writer.writeSample(prefix + "interests_received_total", MetricsWriter::makeLabel("pattern", patternId + 1),
+                         m_processingStatistics[patternId].m_nInterestsReceived);
+    }
+
+    struct Phase
+    {
+      const char* name;
+      Histogram ProcessingStatistics::*histogram;
+    };
+    static const Phase phases[] = {
+      {"construction", &ProcessingStatistics::m_constructionTime},
+      {"content", &ProcessingStatistics::m_contentTime},
+      {"signing", &ProcessingStatistics::m_signingTime},
+      {"delay", &ProcessingStatistics::m_delayTime},
+      {"response_delay", &ProcessingStatistics::m_responseDelay},
+      {"put", &ProcessingStatistics::m_putTime},
+    };
+
+    writer.writeHeader(prefix + "processing_seconds", "histogram", "Time spent answering an Interest");
+    writer.writeHeader(prefix + "phase_seconds", "histogram", "Time spent in each phase of answering an Interest");
+    writer.writeHeader(prefix + "queueing_delay_seconds", "histogram",
+                       "Time from reading an Interest until its processing started");
+    for (std::size_t patternId = 0; patternId < m_processingStatistics.size(); patternId++) {
+      const auto& stats = m_processingStatistics[patternId];
+      auto label = MetricsWriter::makeLabel("pattern", patternId + 1);
+      writer.writeHistogram(prefix + "processing_seconds", label, stats.m_processingTime);
+      for (const auto& phase : phases) {
+        writer.writeHistogram(prefix + "phase_seconds", label + ",phase=\"" + phase.name + '"',
+                              stats.*phase.histogram);
+      }
+      if (hasQueueingDelay()) {
+        writer.writeHistogram(prefix + "queueing_delay_seconds", label, stats.m_queueingDelay);
+      }
+    }
+
+    if (m_queueCapacity) {
+      writer.writeHeader(prefix + "interests_shed_total", "counter", "Interests not answered due to overload");
+      for (std::size_t patternId = 0; patternId < m_processingStatistics.size(); patternId++) {
+        const auto& stats = m_processingStatistics[patternId];
+        auto label = MetricsWriter::makeLabel("pattern", patternId + 1);
+        writer.writeSample(prefix + "interests_shed_total", label + ",reason=\"full\"", stats.m_nInterestsDropped);
+        writer.writeSample(prefix + "interests_shed_total", label + ",reason=\"expired\"", stats.m_nInterestsExpired);
+        writer.writeSample(prefix + "interests_shed_total", label + ",reason=\"nack\"", stats.m_nInterestsNacked);
+      }
+      writer.writeHeader(prefix + "work_queue_length", "gauge", "Interests waiting to be answered");
+      writer.writeSample(prefix + "work_queue_length", "", m_queue.size());
+    }
+
+    writer.writeHeader(prefix + "registration_failures_total", "counter", "Prefixes that could not be registered");
+    writer.writeSample(prefix + "registration_failures_total", "", m_nRegistrationsFailed);
+    writeMemoryMetrics(writer, prefix, MemoryUsage::read());
+
+    if (m_batchingTransport) {
+      writeTransportMetrics(writer, prefix, m_batchingTransport->getCounters());
     }
   }
 
   bool
-  checkTrafficPatternCorrectness() const
+  checkTrafficPatternCorrectness()
   {
-    // TODO
+    // each name can be served by only one pattern
+    std::map<std::string, std::size_t> patternIds;
+    for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
+      auto [it, isNew] = patternIds.emplace(m_trafficPatterns[patternId].m_nameTemplate.toUri(), patternId);
+      if (!isNew) {
+        m_logger.log("ERROR: Traffic Pattern Types #" + std::to_string(it->second + 1) + " and #" +
+                     std::to_string(patternId + 1) + " have the same Name " + it->first, false, true);
+        return false;
+      }
+    }
     return true;
   }
 
-  static std::string
-  getRandomByteString(std::size_t length)
+  static ndn::ConstBufferPtr
+  getRandomBytes(std::size_t length)
+  {
+    auto buffer = std::make_shared<ndn::Buffer>(length);
+    random::fillBytes(buffer->data(), length);
+    return buffer;
+  }
+
+  /**
+   * \brief Hands \p interest to the first of \p patternIds whose name family contains it.
+   *
+   * Interests under a registered prefix that belong to none of the families are not answered.
+   */
+  void
+  dispatchInterest(const ndn::Interest& interest, const std::vector<std::size_t>& patternIds)
+  {
+    if (m_isDraining) {
+      return;
+    }
+    for (auto patternId : patternIds) {
+      if (m_trafficPatterns[patternId].m_nameTemplate.match(interest.getName())) {
+        std::optional<std::chrono::steady_clock::time_point> arrivalTime;
+        if (m_batchingTransport) {
+          arrivalTime = m_batchingTransport->getLastReceiveTime();
+        }
+        if (m_queueCapacity) {
+          admitInterest(interest, patternId, arrivalTime.value_or(std::chrono::steady_clock::now()));
+        }
+        else {
+          onInterest(interest, patternId, arrivalTime);
+        }
+        return;
+      }
+    }
+  }
+
+  /**
+   * \brief Appends \p interest to the work queue, or sheds it if the queue is full.
+   *
+   * The queue is served by one handler per Interest posted to the io_context, so that the
+   * Interests arriving meanwhile are admitted or shed on arrival instead of piling up in the
+   * socket buffers.
+   */
+  void
+  admitInterest(const ndn::Interest& interest, std::size_t patternId,
+                std::chrono::steady_clock::time_point arrivalTime)
+  {
+    if (m_queue.size() >= *m_queueCapacity && m_overloadPolicy == OverloadPolicy::DROP_STALE) {
+      auto now = std::chrono::steady_clock::now();
+      auto end = std::remove_if(m_queue.begin(), m_queue.end(), [&] (const auto& item) {
+        if (!isExpired(item, now)) {
+          return false;
+        }
+        getProcessingStatistics(item.patternId, now).m_nInterestsExpired++;
+        return true;
+      });
+      m_queue.erase(end, m_queue.end());
+    }
+
+    if (m_queue.size() >= *m_queueCapacity) {
+      auto& stats = getProcessingStatistics(patternId, arrivalTime);
+      if (m_overloadPolicy == OverloadPolicy::NACK) {
+        stats.m_nInterestsNacked++;
+        putApplicationNack(interest);
+      }
+      else {
+        stats.m_nInterestsDropped++;
+      }
+      return;
+    }
+
+    m_queue.push_back({interest, patternId, arrivalTime});
+    m_maxQueueLength = std::max(m_maxQueueLength, m_queue.size());
+    if (m_queue.size() == 1) {
+      boost::asio::post(m_io, [this] { processQueue(); });
+    }
+  }
+
+  void
+  processQueue()
+  {
+    if (m_nMaximumInterests && m_nInterestsReceived >= *m_nMaximumInterests) {
+      // the server is done, the remaining Interests are left unanswered
+      m_queue.clear();
+    }
+    if (m_queue.empty()) {
+      return;
+    }
+
+    auto item = std::move(m_queue.front());
+    m_queue.pop_front();
+    auto now = std::chrono::steady_clock::now();
+    if (m_overloadPolicy == OverloadPolicy::DROP_STALE && isExpired(item, now)) {
+      getProcessingStatistics(item.patternId, now).m_nInterestsExpired++;
+    }
+    else {
+      onInterest(item.interest, item.patternId, item.arrivalTime);
+    }
+
+    if (!m_queue.empty()) {
+      boost::asio::post(m_io, [this] { processQueue(); });
+    }
+    else {
+      finishIfDone();
+    }
+  }
+
+  static bool
+  isExpired(const QueuedInterest& item, std::chrono::steady_clock::time_point now)
+  {
+    return item.arrivalTime + item.interest.getInterestLifetime() <= now;
+  }
+
+  /**
+   * \brief Answers \p interest with a Data of ContentType Nack, signed with a digest to keep it cheap.
+   */
+  void
+  putApplicationNack(const ndn::Interest& interest)
   {
-    // per ISO C++ std, cannot instantiate uniform_int_distribution with char
-    static std::uniform_int_distribution<short> dist(std::numeric_limits<char>::min(),
-                                                     std::numeric_limits<char>::max());
+    ndn::Data nack(interest.getName());
+    nack.setContentType(ndn::tlv::ContentType_Nack);
+    nack.setFreshnessPeriod(0_ms);
+    m_keyChain.sign(nack, ndn::security::signingWithSha256());
 
-    std::string s;
-    s.reserve(length);
-    for (std::size_t i = 0; i < length; i++) {
-      s += static_cast<char>(dist(ndn::random::getRandomNumberEngine()));
+    if (m_rawFace) {
+      m_rawFace->put(nack);
+    }
+    else {
+      m_face->put(nack);
     }
-    return s;
   }
 
+  /**
+   * \param arrivalTime when \p interest was read from the forwarder socket, if known
+   */
   void
-  onInterest(const ndn::Interest& interest, std::size_t patternId)
+  onInterest(const ndn::Interest& interest, std::size_t patternId,
+             std::optional<std::chrono::steady_clock::time_point> arrivalTime)
   {
     auto& pattern = m_trafficPatterns[patternId];
 
     if (!m_nMaximumInterests || m_nInterestsReceived < *m_nMaximumInterests) {
+      auto startTime = std::chrono::steady_clock::now();
+      auto& stats = getProcessingStatistics(patternId, startTime);
+      if (arrivalTime) {
+        stats.m_queueingDelay.record(startTime - *arrivalTime);
+      }
+
+      if (pattern.m_dropPercentage > 0.0 || pattern.m_nackPercentage > 0.0) {
+        static std::uniform_real_distribution<> dist(0.0, 100.0);
+        double key = dist(random::getEngine());
+        if (key < pattern.m_dropPercentage) {
+          stats.m_nDropsInjected++;
+          return;
+        }
+        if (key < pattern.m_dropPercentage + pattern.m_nackPercentage) {
+          stats.m_nNacksInjected++;
+          ndn::lp::Nack nack(interest);
+          nack.setReason(pattern.m_nackReason);
+          if (m_rawFace) {
+            m_rawFace->put(nack);
+          }
+          else {
+            m_face->put(nack);
+          }
+          return;
+        }
+      }
+
       ndn::Data data(interest.getName());
 
       if (pattern.m_freshnessPeriod >= 0_ms)
@@ -277,38 +1031,223 @@ private:
       if (pattern.m_contentType)
         data.setContentType(*pattern.m_contentType);
 
-      std::string content;
-      if (pattern.m_contentLength > 0)
-        content = getRandomByteString(*pattern.m_contentLength);
-      if (!pattern.m_content.empty())
-        content = pattern.m_content;
-      data.setContent(ndn::makeStringBlock(ndn::tlv::Content, content));
+      auto contentTime = std::chrono::steady_clock::now();
+      stats.m_constructionTime.record(contentTime - startTime);
+
+      if (pattern.m_contentBlock)
+        data.setContent(*pattern.m_contentBlock);
+      else if (pattern.m_contentLength > 0)
+        data.setContent(getRandomBytes(*pattern.m_contentLength));
+      else
+        data.setContent(ndn::makeStringBlock(ndn::tlv::Content, ""));
+
+      auto signingTime = std::chrono::steady_clock::now();
+      stats.m_contentTime.record(signingTime - contentTime);
 
       m_keyChain.sign(data, pattern.m_signingInfo);
 
+      stats.m_signingTime.record(std::chrono::steady_clock::now() - signingTime);
+
       m_nInterestsReceived++;
-      pattern.m_nInterestsReceived++;
+      pattern.m_nInterestsAnswered++;
+      stats.m_nInterestsReceived++;
 
       if (!m_wantQuiet) {
         auto logLine = "Interest Received          - PatternType=" + std::to_string(patternId + 1) +
                        ", GlobalID=" + std::to_string(m_nInterestsReceived) +
-                       ", LocalID=" + std::to_string(pattern.m_nInterestsReceived) +
+                       ", LocalID=" + std::to_string(pattern.m_nInterestsAnswered) +
                        ", Name=" + interest.getName().toUri();
         m_logger.log(logLine, true, false);
       }
 
+      auto delayTime = std::chrono::steady_clock::now();
       if (pattern.m_contentDelay > 0ms)
         std::this_thread::sleep_for(pattern.m_contentDelay);
       if (m_contentDelay > 0ms)
         std::this_thread::sleep_for(m_contentDelay);
 
-      m_face.put(data);
+      auto putTime = std::chrono::steady_clock::now();
+      stats.m_delayTime.record(putTime - delayTime);
+
+      if (pattern.m_responseDelay) {
+        auto delay = (*pattern.m_responseDelay)(random::getEngine());
+        scheduleResponse(std::move(data), patternId, putTime + delay);
+        stats.m_processingTime.record(std::chrono::steady_clock::now() - startTime);
+        return;
+      }
+
+      if (m_rawFace) {
+        m_rawFace->put(data);
+      }
+      else {
+        m_face->put(data);
+      }
+
+      auto endTime = std::chrono::steady_clock::now();
+      stats.m_putTime.record(endTime - putTime);
+      stats.m_processingTime.record(endTime - startTime);
     }
 
-    if (m_nMaximumInterests && m_nInterestsReceived >= *m_nMaximumInterests) {
-      logStatistics();
-      m_registeredPrefixes.clear();
-      m_signalSet.cancel();
+    finishIfDone();
+  }
+
+  /**
+   * \brief Sends \p data at \p dueTime without blocking the processing of other Interests.
+   *
+   * All delayed responses share one timer, which is set to the earliest of them.
+   */
+  void
+  scheduleResponse(ndn::Data data, std::size_t patternId, std::chrono::steady_clock::time_point dueTime)
+  {
+    m_delayedResponses.push({dueTime, m_nResponsesScheduled++, patternId, std::chrono::steady_clock::now(),
+                             std::move(data)});
+    if (m_delayedResponses.top().sequence == m_nResponsesScheduled - 1) {
+      // the new response is the earliest one
+      waitForDueResponses();
+    }
+  }
+
+  void
+  waitForDueResponses()
+  {
+    // this cancels the pending wait, if any
+    m_responseTimer.expires_at(m_delayedResponses.top().dueTime);
+    m_responseTimer.async_wait([this] (const boost::system::error_code& ec) {
+      if (!ec) {
+        sendDueResponses();
+      }
+    });
+  }
+
+  void
+  sendDueResponses()
+  {
+    auto now = std::chrono::steady_clock::now();
+    while (!m_delayedResponses.empty() && m_delayedResponses.top().dueTime <= now) {
+      const auto& response = m_delayedResponses.top();
+      // the response is accounted to the period in which its Interest was processed
+      auto& stats = getProcessingStatistics(response.patternId, response.scheduledTime);
+      // earlier responses of this pass delay the put of the later ones
+      auto putTime = std::chrono::steady_clock::now();
+      stats.m_responseDelay.record(putTime - response.scheduledTime);
+      if (m_rawFace) {
+        m_rawFace->put(response.data);
+      }
+      else {
+        m_face->put(response.data);
+      }
+      stats.m_putTime.record(std::chrono::steady_clock::now() - putTime);
+      m_delayedResponses.pop();
+    }
+
+    if (!m_delayedResponses.empty()) {
+      waitForDueResponses();
+    }
+    finishIfDone();
+  }
+
+  /**
+   * \brief The first SIGINT or SIGTERM starts draining, a second one stops the server right away.
+   */
+  void
+  waitForSignal()
+  {
+    m_signalSet.async_wait([this] (const boost::system::error_code& ec, int) {
+      if (ec) {
+        return;
+      }
+      if (m_nMaximumInterests && m_nInterestsReceived < *m_nMaximumInterests) {
+        m_hasError = true;
+      }
+      if (!m_isDraining) {
+        startDrain("Serving interrupted");
+        waitForSignal();
+        return;
+      }
+      m_logger.log("Interrupted again, stopping without sending " + std::to_string(getPendingResponses()) +
+                   " pending responses", true, true);
+      m_drainTimer.cancel();
+      stop();
+    });
+  }
+
+  /**
+   * \brief Stops accepting Interests, but answers those that are queued or whose response is
+   *        delayed, so that the clients do not count them as lost.
+   *
+   * This is bounded by the drain period, after which the server stops even if some responses
+   * are still pending.
+   */
+  void
+  startDrain(const std::string& reason)
+  {
+    if (m_isDraining || m_isDone) {
+      return;
+    }
+    m_isDraining = true;
+    m_registeredPrefixes.clear();
+    m_durationTimer.cancel();
+    m_logger.log(reason, true, true);
+    if (getPendingResponses() == 0) {
+      finishIfDone();
+      return;
+    }
+
+    m_logger.log("Waiting up to " + formatMilliseconds(m_drainPeriod) + " for " +
+                 std::to_string(getPendingResponses()) + " pending responses", true, true);
+    m_drainTimer.expires_after(m_drainPeriod);
+    m_drainTimer.async_wait([this] (const boost::system::error_code& ec) {
+      if (ec || m_isDone) {
+        return;
+      }
+      m_isDone = true;
+      m_logger.log("WARNING: " + std::to_string(getPendingResponses()) +
+                   " responses still pending at the end of the drain period", true, true);
+      stop();
+    });
+  }
+
+  std::size_t
+  getPendingResponses() const
+  {
+    return m_queue.size() + m_delayedResponses.size();
+  }
+
+  /**
+   * \brief Stops serving once the maximum number of Interests has been answered, or serving
+   *        has been interrupted, and all their Data has been sent.
+   */
+  void
+  finishIfDone()
+  {
+    if (m_isDone) {
+      return;
+    }
+    if (m_isDraining) {
+      if (getPendingResponses() == 0) {
+        m_isDone = true;
+        m_drainTimer.cancel();
+        stop();
+      }
+      return;
+    }
+    if (!m_nMaximumInterests || m_nInterestsReceived < *m_nMaximumInterests || !m_delayedResponses.empty()) {
+      return;
+    }
+    m_isDone = true;
+
+    logStatistics();
+    if (m_rawFace) {
+      // closes the connection once the last Data has been written
+      m_rawFace->shutdown();
+    }
+    m_registeredPrefixes.clear();
+    m_signalSet.cancel();
+    m_reportTimer.cancel();
+    m_durationTimer.cancel();
+    // a pending accept would keep the io_context running
+    if (m_metricsExporter) {
+      m_metricsExporter->stop();
     }
   }
 
@@ -331,7 +1270,12 @@ private:
   stop()
   {
     logStatistics();
-    m_face.shutdown();
+    if (m_rawFace) {
+      m_rawFace->shutdown();
+    }
+    else {
+      m_face->shutdown();
+    }
     m_io.stop();
   }
 
@@ -339,20 +1283,46 @@ private:
   Logger m_logger{"NdnTrafficServer"};
   boost::asio::io_context m_io;
   boost::asio::signal_set m_signalSet{m_io, SIGINT, SIGTERM};
-  ndn::Face m_face{m_io};
+  boost::asio::steady_timer m_reportTimer{m_io};
+  boost::asio::steady_timer m_responseTimer{m_io};
+  boost::asio::steady_timer m_drainTimer{m_io};
+  boost::asio::steady_timer m_durationTimer{m_io};
+  std::shared_ptr<BatchingTransport> m_batchingTransport;
   ndn::KeyChain m_keyChain;
+  std::optional<ndn::Face> m_face;
+  std::optional<RawFace> m_rawFace;
+  std::optional<MetricsExporter> m_metricsExporter;
 
   std::string m_configurationFile;
   std::string m_timestampFormat;
+  std::string m_metricsSocket;
   std::optional<uint64_t> m_nMaximumInterests;
   std::chrono::milliseconds m_contentDelay{0};
+  std::chrono::milliseconds m_drainPeriod{ndn::DEFAULT_INTEREST_LIFETIME};
+  std::optional<std::chrono::milliseconds> m_reportInterval;
+  std::optional<std::size_t> m_queueCapacity;
+  OverloadPolicy m_overloadPolicy = OverloadPolicy::DROP_TAIL;
+  std::deque<QueuedInterest> m_queue;
+  std::size_t m_maxQueueLength = 0;
+  std::priority_queue<DelayedResponse, std::vector<DelayedResponse>, std::greater<>> m_delayedResponses;
+  uint64_t m_nResponsesScheduled = 0;
 
   std::vector<DataTrafficConfiguration> m_trafficPatterns;
+  std::vector<ProcessingStatistics> m_processingStatistics;
+  /// Interests handled during the warm-up and the cool-down, which are not in m_processingStatistics
+  std::vector<ProcessingStatistics> m_warmupStatistics;
+  std::vector<ProcessingStatistics> m_cooldownStatistics;
+  RunPeriods m_runPeriods;
   std::vector<ndn::ScopedRegisteredPrefixHandle> m_registeredPrefixes;
   uint64_t m_nRegistrationsFailed = 0;
   uint64_t m_nInterestsReceived = 0;
 
   bool m_wantQuiet = false;
+  bool m_wantBatchedWrites = false;
+  bool m_wantRawEngine = false;
+  ExecutionMode m_executionMode;
+  bool m_isDraining = false;
+  bool m_isDone = false;
   bool m_hasError = false;
 };
 
@@ -385,7 +1355,28 @@ main(int argc, char* argv[])
     ("delay,d",   po::value<std::chrono::milliseconds::rep>()->default_value(0),
                   "wait this amount of milliseconds before responding to each Interest")
     ("timestamp-format,t", po::value<std::string>(&timestampFormat), "format string for timestamp output")
+    ("coarse-timestamps", po::bool_switch(), "take log timestamps from a cheaper clock with millisecond resolution")
     ("quiet,q",   po::bool_switch(), "turn off logging of Interest reception and Data generation")
+    ("metrics-socket", po::value<std::string>(), "serve live metrics in Prometheus format on this Unix socket")
+    ("report-interval", po::value<std::chrono::milliseconds::rep>(),
+                  "log the progress, processing times, and memory usage every this many milliseconds")
+    ("drain-period", po::value<std::chrono::milliseconds::rep>(),
+                  "once interrupted, keep sending queued and delayed responses for at most this many "
+                  "milliseconds (default: the default InterestLifetime)")
+    ("duration",  po::value<std::string>(), "stop serving after this time, e.g., 90s or 10m")
+    ("warmup",    po::value<std::string>(), "report the processing of Interests during this initial time separately")
+    ("cooldown",  po::value<std::string>(),
+                  "report the processing of Interests during this final time of the --duration separately")
+    ("queue-size", po::value<std::size_t>(), "queue at most this many Interests and shed the excess")
+    ("overload-policy", po::value<std::string>()->default_value("drop-tail"),
+                  "how to shed Interests when the queue is full: 'drop-tail', 'drop-stale', or 'nack'")
+    ("batch-writes", po::bool_switch(), "write all Data of one event loop pass to the forwarder at once")
+    ("engine",    po::value<std::string>()->default_value("face"),
+                  "packet engine: 'face' (ndn-cxx Face) or 'raw' (direct forwarder connection, implies --batch-writes)")
+    ("cpu-affinity", po::value<std::string>(), "run on these CPUs only, e.g., 2 or 4-7,12")
+    ("numa-local", po::bool_switch(), "allocate memory on the NUMA node of the CPU running the server")
+    ("busy-poll", po::bool_switch(), "poll for events in a loop instead of sleeping, to cut wakeup latency")
+    ("seed",      po::value<uint64_t>(), "make the generated responses reproducible by seeding the random numbers")
     ;
 
   po::options_description hiddenOptions;
@@ -443,13 +1434,106 @@ main(int argc, char* argv[])
     server.setContentDelay(delay);
   }
 
+  try {
+    auto option = [&vm] (const char* name) {
+      return vm.count(name) > 0 ? vm[name].as<std::string>() : "";
+    };
+    server.setRunPeriods(ndntg::RunPeriods::parse(option("duration"), option("warmup"), option("cooldown")));
+  }
+  catch (const std::invalid_argument& e) {
+    std::cerr << "ERROR: " << e.what() << "\n";
+    return 2;
+  }
+
+  if (vm.count("drain-period") > 0) {
+    std::chrono::milliseconds period(vm["drain-period"].as<std::chrono::milliseconds::rep>());
+    if (period < 0ms) {
+      std::cerr << "ERROR: the argument for option '--drain-period' cannot be negative\n";
+      return 2;
+    }
+    server.setDrainPeriod(period);
+  }
+
   if (!timestampFormat.empty()) {
     server.setTimestampFormat(std::move(timestampFormat));
   }
 
+  if (vm["coarse-timestamps"].as<bool>()) {
+    server.setCoarseTimestamps();
+  }
+
   if (vm["quiet"].as<bool>()) {
     server.setQuietLogging();
   }
 
+  if (vm.count("metrics-socket") > 0) {
+    server.setMetricsSocket(vm["metrics-socket"].as<std::string>());
+  }
+
+  if (vm.count("report-interval") > 0) {
+    std::chrono::milliseconds interval(vm["report-interval"].as<std::chrono::milliseconds::rep>());
+    if (interval <= 0ms) {
+      std::cerr << "ERROR: the argument for option '--report-interval' must be positive\n";
+      return 2;
+    }
+    server.setReportInterval(interval);
+  }
+
+  auto overloadPolicy = vm["overload-policy"].as<std::string>();
+  auto policy = ndntg::NdnTrafficServer::OverloadPolicy::DROP_TAIL;
+  if (overloadPolicy == "drop-stale") {
+    policy = ndntg::NdnTrafficServer::OverloadPolicy::DROP_STALE;
+  }
+  else if (overloadPolicy == "nack") {
+    policy = ndntg::NdnTrafficServer::OverloadPolicy::NACK;
+  }
+  else if (overloadPolicy != "drop-tail") {
+    std::cerr << "ERROR: the argument for option '--overload-policy' must be 'drop-tail', 'drop-stale', or 'nack'\n";
+    return 2;
+  }
+
+  if (vm.count("queue-size") > 0) {
+    auto queueSize = vm["queue-size"].as<std::size_t>();
+    if (queueSize == 0) {
+      std::cerr << "ERROR: the argument for option '--queue-size' must be positive\n";
+      return 2;
+    }
+    server.setWorkQueue(queueSize, policy);
+  }
+  else if (!vm["overload-policy"].defaulted()) {
+    std::cerr << "ERROR: '--overload-policy' requires '--queue-size'\n";
+    return 2;
+  }
+
+  if (vm["batch-writes"].as<bool>()) {
+    server.setBatchedWrites();
+  }
+
+  auto engine = vm["engine"].as<std::string>();
+  if (engine == "raw") {
+    server.setRawEngine();
+  }
+  else if (engine != "face") {
+    std::cerr << "ERROR: the argument for option '--engine' must be 'face' or 'raw'\n";
+    return 2;
+  }
+
+  ndntg::ExecutionMode executionMode;
+  if (vm.count("cpu-affinity") > 0) {
+    auto cpus = ndntg::ExecutionMode::parseCpuList(vm["cpu-affinity"].as<std::string>());
+    if (!cpus) {
+      std::cerr << "ERROR: the argument for option '--cpu-affinity' must be a list of CPUs, e.g., 0,2-3\n";
+      return 2;
+    }
+    executionMode.cpus = std::move(*cpus);
+  }
+  executionMode.wantLocalMemory = vm["numa-local"].as<bool>();
+  executionMode.wantBusyPoll = vm["busy-poll"].as<bool>();
+  server.setExecutionMode(std::move(executionMode));
+
+  if (vm.count("seed") > 0) {
+    ndntg::random::seed(vm["seed"].as<uint64_t>());
+  }
+
   return server.run();
 }
@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "trace.hpp"
+
+#include <ndn-cxx/name.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+namespace ndntg {
+
+/**
+ * \brief Converts a text trace into the binary trace format.
+ *
+ * Each line of the text trace has the form
+ *
+ *     <timestamp in seconds> <Interest name> [CanBePrefix] [MustBeFresh]
+ *
+ * Timestamps may be absolute (e.g., Unix time) or relative, but must be non-decreasing;
+ * they are stored relative to the first record. Empty lines and lines starting with '#'
+ * are ignored.
+ */
+class TraceConverter
+{
+public:
+  TraceConverter(std::istream& input, std::ostream& output)
+    : m_input(input)
+    , m_writer(output)
+  {
+  }
+
+  bool
+  run()
+  {
+    std::optional<double> firstTimestamp;
+    std::chrono::microseconds lastOffset{0};
+    uint64_t lineNumber = 0;
+    std::string line;
+
+    while (std::getline(m_input, line)) {
+      lineNumber++;
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+
+      std::istringstream is(line);
+      double timestamp = 0.0;
+      std::string uri;
+      if (!(is >> timestamp >> uri) || !std::isfinite(timestamp)) {
+        return fail(lineNumber, "expecting '<timestamp> <name> [CanBePrefix] [MustBeFresh]'");
+      }
+
+      uint8_t flags = 0;
+      std::string flag;
+      while (is >> flag) {
+        if (flag == "CanBePrefix") {
+          flags |= TraceRecord::CAN_BE_PREFIX;
+        }
+        else if (flag == "MustBeFresh") {
+          flags |= TraceRecord::MUST_BE_FRESH;
+        }
+        else {
+          return fail(lineNumber, "unknown flag '" + flag + "'");
+        }
+      }
+
+      if (!firstTimestamp) {
+        firstTimestamp = timestamp;
+      }
+      auto offset = std::chrono::microseconds(std::llround((timestamp - *firstTimestamp) * 1e6));
+      if (offset < lastOffset) {
+        return fail(lineNumber, "timestamps must be non-decreasing (sort the trace first)");
+      }
+
+      ndn::Block wire;
+      try {
+        wire = ndn::Name(uri).wireEncode();
+      }
+      catch (const std::exception& e) {
+        return fail(lineNumber, "invalid name '" + uri + "': " + e.what());
+      }
+
+      m_writer.write(offset, flags, {reinterpret_cast<const char*>(wire.data()), wire.size()});
+      lastOffset = offset;
+      m_nRecords++;
+    }
+
+    m_duration = lastOffset;
+    return true;
+  }
+
+  uint64_t
+  getRecordCount() const
+  {
+    return m_nRecords;
+  }
+
+  std::chrono::microseconds
+  getDuration() const
+  {
+    return m_duration;
+  }
+
+private:
+  static bool
+  fail(uint64_t lineNumber, const std::string& message)
+  {
+    std::cerr << "ERROR: Line " << lineNumber << " - " << message << std::endl;
+    return false;
+  }
+
+private:
+  std::istream& m_input;
+  TraceWriter m_writer;
+  uint64_t m_nRecords = 0;
+  std::chrono::microseconds m_duration{0};
+};
+
+} // namespace ndntg
+
+namespace po = boost::program_options;
+
+static void
+usage(std::ostream& os, std::string_view programName, const po::options_description& desc)
+{
+  os << "Usage: " << programName << " [options] <Text_Trace_File> <Binary_Trace_File>\n"
+     << "\n"
+     << "Convert a text trace of \"<timestamp> <name> [CanBePrefix] [MustBeFresh]\" lines\n"
+     << "into the binary trace format replayed by ndn-traffic-client --trace.\n"
+     << "Use '-' as Text_Trace_File to read from the standard input.\n"
+     << "\n"
+     << desc;
+}
+
+int
+main(int argc, char* argv[])
+{
+  std::string inputFile;
+  std::string outputFile;
+
+  po::options_description visibleOptions("Options");
+  visibleOptions.add_options()
+    ("help,h", "print this help message and exit")
+    ;
+
+  po::options_description hiddenOptions;
+  hiddenOptions.add_options()
+    ("input-file", po::value<std::string>(&inputFile))
+    ("output-file", po::value<std::string>(&outputFile))
+    ;
+
+  po::positional_options_description posOptions;
+  posOptions.add("input-file", 1);
+  posOptions.add("output-file", 1);
+
+  po::options_description allOptions;
+  allOptions.add(visibleOptions).add(hiddenOptions);
+
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv).options(allOptions).positional(posOptions).run(), vm);
+    po::notify(vm);
+  }
+  catch (const po::error& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 2;
+  }
+
+  if (vm.count("help") > 0) {
+    usage(std::cout, argv[0], visibleOptions);
+    return 0;
+  }
+
+  if (inputFile.empty() || outputFile.empty()) {
+    usage(std::cerr, argv[0], visibleOptions);
+    return 2;
+  }
+
+  std::ifstream inputStream;
+  if (inputFile != "-") {
+    inputStream.open(inputFile);
+    if (!inputStream) {
+      std::cerr << "ERROR: Unable to open text trace file: " << inputFile << std::endl;
+      return 2;
+    }
+  }
+  std::ofstream outputStream(outputFile, std::ofstream::binary | std::ofstream::trunc);
+  if (!outputStream) {
+    std::cerr << "ERROR: Unable to create binary trace file: " << outputFile << std::endl;
+    return 2;
+  }
+
+  ndntg::TraceConverter converter(inputFile == "-" ? std::cin : inputStream, outputStream);
+  if (!converter.run()) {
+    return 1;
+  }
+  outputStream.close();
+  if (!outputStream) {
+    std::cerr << "ERROR: Unable to write binary trace file: " << outputFile << std::endl;
+    return 1;
+  }
+
+  std::cout << "Converted " << converter.getRecordCount() << " records spanning "
+            << converter.getDuration().count() / 1e6 << " seconds" << std::endl;
+  return 0;
+}
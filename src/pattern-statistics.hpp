@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_PATTERN_STATISTICS_HPP
+#define NDNTG_PATTERN_STATISTICS_HPP
+
+#include "histogram.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace ndntg {
+
+/**
+ * \brief Counters of one traffic pattern that are updated for every packet.
+ *
+ * They are kept apart from the configuration, which the packet path only reads, and aligned
+ * to a cache line so that the blocks of different patterns never share one. Totals are
+ * obtained by merging the blocks when a report is produced, thus each packet updates only
+ * the block of its own pattern. Blocks filled independently, e.g., by different threads,
+ * can be combined in the same way.
+ */
+class alignas(64) PatternStatistics
+{
+public:
+  void
+  merge(const PatternStatistics& other)
+  {
+    m_nInterestsSent += other.m_nInterestsSent;
+    m_nInterestsReceived += other.m_nInterestsReceived;
+    m_nNacks += other.m_nNacks;
+    m_nTimeouts += other.m_nTimeouts;
+    m_nContentInconsistencies += other.m_nContentInconsistencies;
+    m_nDataValidated += other.m_nDataValidated;
+    m_nValidationFailures += other.m_nValidationFailures;
+    m_minimumInterestRoundTripTime = std::min(m_minimumInterestRoundTripTime,
+                                              other.m_minimumInterestRoundTripTime);
+    m_maximumInterestRoundTripTime = std::max(m_maximumInterestRoundTripTime,
+                                              other.m_maximumInterestRoundTripTime);
+    m_totalInterestRoundTripTime += other.m_totalInterestRoundTripTime;
+    m_rttHistogram.merge(other.m_rttHistogram);
+    m_responseTimeHistogram.merge(other.m_responseTimeHistogram);
+    m_timeoutHistogram.merge(other.m_timeoutHistogram);
+    m_validationTimeHistogram.merge(other.m_validationTimeHistogram);
+    m_nRerequestsSent += other.m_nRerequestsSent;
+    m_nRerequestsSatisfied += other.m_nRerequestsSatisfied;
+    m_rerequestRttHistogram.merge(other.m_rerequestRttHistogram);
+    m_nBursts += other.m_nBursts;
+    m_nSharedDataArrivals += other.m_nSharedDataArrivals;
+    m_nDuplicateNacks += other.m_nDuplicateNacks;
+    m_nOutstanding += other.m_nOutstanding;
+  }
+
+  uint64_t
+  getCompleted() const
+  {
+    return m_nInterestsReceived + m_nNacks + m_nTimeouts;
+  }
+
+public:
+  uint64_t m_nInterestsSent = 0;
+  uint64_t m_nInterestsReceived = 0;
+  uint64_t m_nNacks = 0;
+  uint64_t m_nTimeouts = 0;
+  uint64_t m_nContentInconsistencies = 0;
+  uint64_t m_nDataValidated = 0;
+  uint64_t m_nValidationFailures = 0;
+
+  // RTT is stored as milliseconds with fractional sub-milliseconds precision
+  double m_minimumInterestRoundTripTime = std::numeric_limits<double>::max();
+  double m_maximumInterestRoundTripTime = 0;
+  double m_totalInterestRoundTripTime = 0;
+  Histogram m_rttHistogram;
+  Histogram m_responseTimeHistogram;
+  /// time from sending an Interest until its timeout fired, to be compared with its lifetime
+  Histogram m_timeoutHistogram;
+  /// time from the reception of Data until the verdict on their signature, which is not part of the RTT
+  Histogram m_validationTimeHistogram;
+  /// Interests for recently satisfied names, whose RTT is also recorded on its own
+  uint64_t m_nRerequestsSent = 0;
+  uint64_t m_nRerequestsSatisfied = 0;
+  Histogram m_rerequestRttHistogram;
+  uint64_t m_nBursts = 0;
+  /// Data delivered to an Interest of a burst after the same Data was delivered to another one
+  uint64_t m_nSharedDataArrivals = 0;
+  uint64_t m_nDuplicateNacks = 0;
+  /// Interests awaiting their Data, Nack, or timeout, whichever period they were sent in;
+  /// not cleared by a reset, as it drives SustainOutstanding rather than the report
+  uint64_t m_nOutstanding = 0;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_PATTERN_STATISTICS_HPP
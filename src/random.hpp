@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_RANDOM_HPP
+#define NDNTG_RANDOM_HPP
+
+#include <ndn-cxx/util/random.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <random>
+
+namespace ndntg::random {
+
+/**
+ * \brief Random number generation for everything that shapes the generated traffic, e.g.,
+ *        pattern selection, names, nonces, payloads, drops, and delays.
+ *
+ * By default, this is the engine of ndn-cxx, which is seeded from the operating system. Once
+ * seed() has been called, every thread instead draws from an engine of its own, seeded from the
+ * run seed and the stream number of the thread. Streams are derived with SplitMix64, thus they
+ * are statistically independent, and a thread produces the same sequence in every run with
+ * the same seed, regardless of how the threads are scheduled.
+ */
+using Engine = ndn::random::RandomNumberEngine;
+
+namespace detail {
+
+inline std::optional<uint64_t> g_seed;
+inline thread_local uint64_t t_stream = 0;
+inline thread_local std::optional<Engine> t_engine;
+
+inline uint64_t
+splitMix64(uint64_t& state)
+{
+  uint64_t z = (state += 0x9e3779b97f4a7c15);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+
+} // namespace detail
+
+/**
+ * \brief Makes all subsequently created engines deterministic.
+ *
+ * Must be called before any thread draws a random number.
+ */
+inline void
+seed(uint64_t seed)
+{
+  detail::g_seed = seed;
+}
+
+inline std::optional<uint64_t>
+getSeed()
+{
+  return detail::g_seed;
+}
+
+/**
+ * \brief Selects the stream of the calling thread; the main thread uses stream 0.
+ *
+ * Threads that are started in a fixed order should be given consecutive stream numbers
+ * before they draw any random number.
+ */
+inline void
+setThreadStream(uint64_t stream)
+{
+  detail::t_stream = stream;
+  detail::t_engine.reset();
+}
+
+inline Engine&
+getEngine()
+{
+  if (!detail::g_seed) {
+    return ndn::random::getRandomNumberEngine();
+  }
+
+  if (!detail::t_engine) {
+    // the state of the engine is filled from a SplitMix64 sequence that is unique to the stream
+    uint64_t stream = detail::t_stream;
+    uint64_t state = *detail::g_seed ^ detail::splitMix64(stream);
+    std::array<uint32_t, 16> seeds;
+    for (std::size_t i = 0; i < seeds.size(); i += 2) {
+      auto word = detail::splitMix64(state);
+      seeds[i] = static_cast<uint32_t>(word);
+      seeds[i + 1] = static_cast<uint32_t>(word >> 32);
+    }
+    std::seed_seq seq(seeds.begin(), seeds.end());
+    detail::t_engine.emplace(seq);
+  }
+  return *detail::t_engine;
+}
+
+inline uint32_t
+generateWord32()
+{
+  return static_cast<uint32_t>(getEngine()());
+}
+
+/**
+ * \brief Fills \p count bytes at \p first with random bytes.
+ *
+ * Every output of the engine supplies four bytes, instead of one byte per draw from a
+ * uniform_int_distribution.
+ */
+inline void
+fillBytes(uint8_t* first, std::size_t count)
+{
+  static_assert(Engine::min() == 0 && Engine::max() == 0xffffffff, "the engine must produce 32-bit words");
+
+  auto& engine = getEngine();
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    auto word = static_cast<uint32_t>(engine());
+    std::memcpy(first + i, &word, 4);
+  }
+  if (i < count) {
+    auto word = static_cast<uint32_t>(engine());
+    std::memcpy(first + i, &word, count - i);
+  }
+}
+
+} // namespace ndntg::random
+
+#endif // NDNTG_RANDOM_HPP
@@ -0,0 +1,528 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_RAW_FACE_HPP
+#define NDNTG_RAW_FACE_HPP
+
+#include "batching-transport.hpp"
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/face.hpp>
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/lp/nack.hpp>
+#include <ndn-cxx/lp/packet.hpp>
+#include <ndn-cxx/lp/tags.hpp>
+#include <ndn-cxx/mgmt/control-response.hpp>
+#include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
+#include <ndn-cxx/security/interest-signer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/core/noncopyable.hpp>
+
+namespace ndntg {
+
+namespace detail {
+
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325;
+
+/**
+ * \brief Extends the FNV-1a hash \p hash of some name components by \p component.
+ */
+inline uint64_t
+hashNameComponent(uint64_t hash, const ndn::name::Component& component)
+{
+  constexpr uint64_t FNV_PRIME = 0x100000001b3;
+  // type and length are included, so that the concatenation of components is unambiguous
+  for (uint64_t value : {uint64_t{component.type()}, uint64_t{component.value_size()}}) {
+    for (int i = 0; i < 8; i++) {
+      hash = (hash ^ ((value >> (i * 8)) & 0xff)) * FNV_PRIME;
+    }
+  }
+  for (auto byte : component.value_bytes()) {
+    hash = (hash ^ byte) * FNV_PRIME;
+  }
+  return hash;
+}
+
+} // namespace detail
+
+/**
+ * \brief Returns a hash of \p name that does not depend on how its components were constructed.
+ */
+inline uint64_t
+hashName(const ndn::Name& name)
+{
+  uint64_t hash = detail::FNV_OFFSET_BASIS;
+  for (const auto& component : name) {
+    hash = detail::hashNameComponent(hash, component);
+  }
+  return hash;
+}
+
+/**
+ * \brief Returns the hashes of all prefixes of \p name, from the shortest (no component)
+ *        to \p name itself.
+ */
+inline std::vector<uint64_t>
+hashNamePrefixes(const ndn::Name& name)
+{
+  std::vector<uint64_t> hashes;
+  hashes.reserve(name.size() + 1);
+  hashes.push_back(detail::FNV_OFFSET_BASIS);
+  for (const auto& component : name) {
+    hashes.push_back(detail::hashNameComponent(hashes.back(), component));
+  }
+  return hashes;
+}
+
+/**
+ * \brief A network-layer packet received from the forwarder, with its NDNLPv2 headers removed.
+ */
+struct NetworkPacket
+{
+  ndn::Block wire; ///< the Interest or Data; invalid for NDNLPv2 packets without a fragment
+  std::optional<ndn::lp::NackHeader> nackHeader;
+};
+
+/**
+ * \throw ndn::tlv::Error \p wire is not a well-formed packet
+ */
+inline NetworkPacket
+decodeNetworkPacket(const ndn::Block& wire)
+{
+  // the forwarder sends bare Interests and Data unless it has NDNLPv2 headers to attach
+  if (wire.type() != ndn::lp::tlv::LpPacket) {
+    return {wire, std::nullopt};
+  }
+
+  ndn::lp::Packet lpPacket(wire);
+  if (!lpPacket.has<ndn::lp::FragmentField>()) {
+    return {};
+  }
+  auto [begin, end] = lpPacket.get<ndn::lp::FragmentField>();
+  NetworkPacket packet{ndn::Block(ndn::make_span(&*begin, std::distance(begin, end))), std::nullopt};
+  if (lpPacket.has<ndn::lp::NackField>()) {
+    packet.nackHeader = lpPacket.get<ndn::lp::NackField>();
+  }
+  return packet;
+}
+
+inline ndn::Block
+encodeNack(const ndn::lp::Nack& nack)
+{
+  const auto& interest = nack.getInterest().wireEncode();
+  ndn::lp::Packet lpPacket;
+  lpPacket.add<ndn::lp::NackField>(nack.getHeader());
+  lpPacket.add<ndn::lp::FragmentField>({interest.begin(), interest.end()});
+  return lpPacket.wireEncode();
+}
+
+/**
+ * \brief Minimal replacement of ndn::Face that exchanges packets directly with the forwarder.
+ *
+ * ndn::Face maintains a general-purpose pending Interest table, an Interest filter table, and
+ * one scheduled event per Interest, which limits the packet rate of a single traffic tool well
+ * below what a forwarder can sustain. This face only keeps what a traffic tool needs: pending
+ * Interests in a hash table keyed by name hash, their expiry times in a single heap served by
+ * one timer, and a short list of Interest filters. Packets are exchanged over a
+ * BatchingTransport, so that all packets of one event loop pass are written at once.
+ *
+ * Limitations: of the NDNLPv2 headers, only Nack and NextHopFaceId are supported; Data are
+ * matched to Interests by name only (Interests carrying an implicit digest component are not
+ * supported); and Interest filters are registered with the forwarder but never unregistered,
+ * since the routes disappear with the connection.
+ */
+class RawFace : boost::noncopyable
+{
+public:
+  using InterestHandler = std::function<void(const ndn::Name& prefix, const ndn::Interest&)>;
+
+  /**
+   * \param keyChain signs prefix registration commands; only needed for setInterestFilter()
+   */
+  explicit
+  RawFace(boost::asio::io_context& io, ndn::KeyChain* keyChain = nullptr)
+    : m_io(io)
+    , m_transport(BatchingTransport::create())
+    , m_keyChain(keyChain)
+  {
+  }
+
+  const std::shared_ptr<BatchingTransport>&
+  getTransport() const
+  {
+    return m_transport;
+  }
+
+  std::size_t
+  getNPendingInterests() const
+  {
+    return m_nPendingInterests;
+  }
+
+  void
+  expressInterest(const ndn::Interest& interest, ndn::DataCallback onData,
+                  ndn::NackCallback onNack, ndn::TimeoutCallback onTimeout)
+  {
+    connect();
+
+    auto hash = hashName(interest.getName());
+    auto id = ++m_lastPendingId;
+    auto expiry = std::chrono::steady_clock::now() + interest.getInterestLifetime();
+    m_pendingInterests[hash].push_back({id, interest, std::move(onData), std::move(onNack), std::move(onTimeout)});
+    m_nPendingInterests++;
+    if (interest.getCanBePrefix()) {
+      m_nCanBePrefix++;
+    }
+
+    if (m_expiries.empty() || expiry < m_expiries.top().expiry) {
+      m_timeoutTimer.expires_at(expiry);
+      m_timeoutTimer.async_wait([this] (const boost::system::error_code& ec) {
+        if (!ec) {
+          processTimeouts();
+        }
+      });
+    }
+    m_expiries.push({expiry, hash, id});
+
+    if (auto nextHop = interest.getTag<ndn::lp::NextHopFaceIdTag>(); nextHop != nullptr) {
+      const auto& wire = interest.wireEncode();
+      ndn::lp::Packet lpPacket;
+      lpPacket.add<ndn::lp::NextHopFaceIdField>(nextHop->get());
+      lpPacket.add<ndn::lp::FragmentField>({wire.begin(), wire.end()});
+      m_transport->send(lpPacket.wireEncode());
+    }
+    else {
+      m_transport->send(interest.wireEncode());
+    }
+  }
+
+  /**
+   * \brief Registers \p prefix with the forwarder and dispatches the Interests under it to \p onInterest.
+   * \pre a KeyChain was given to the constructor
+   */
+  void
+  setInterestFilter(const ndn::Name& prefix, InterestHandler onInterest,
+                    ndn::RegisterPrefixFailureCallback onFailure)
+  {
+    m_filters.push_back(std::make_shared<Filter>(Filter{prefix, std::move(onInterest), std::move(onFailure)}));
+    if (m_transport->isConnected()) {
+      registerPrefix(*m_filters.back());
+    }
+  }
+
+  void
+  put(const ndn::Data& data)
+  {
+    m_transport->send(data.wireEncode());
+  }
+
+  void
+  put(const ndn::lp::Nack& nack)
+  {
+    m_transport->send(encodeNack(nack));
+  }
+
+  /**
+   * \brief Connects to the forwarder, if not yet done, and runs the io_context.
+   * \param wantBusyPoll poll the io_context in a loop instead of waiting for events
+   * \throw BatchingTransport::Error the connection failed
+   */
+  void
+  processEvents(bool wantBusyPoll = false)
+  {
+    connect();
+    if (wantBusyPoll) {
+      while (!m_io.stopped()) {
+        m_io.poll();
+      }
+    }
+    else {
+      m_io.run();
+    }
+  }
+
+  /**
+   * \brief Drops all pending Interests and filters, and closes the connection once the
+   *        packets already put have been written.
+   */
+  void
+  shutdown()
+  {
+    m_pendingInterests.clear();
+    m_nPendingInterests = 0;
+    m_nCanBePrefix = 0;
+    m_expiries = {};
+    m_filters.clear();
+    m_timeoutTimer.cancel();
+    m_transport->shutdown();
+  }
+
+private:
+  struct PendingInterest
+  {
+    uint64_t id;
+    ndn::Interest interest;
+    ndn::DataCallback onData;
+    ndn::NackCallback onNack;
+    ndn::TimeoutCallback onTimeout;
+  };
+
+  struct Expiry
+  {
+    std::chrono::steady_clock::time_point expiry;
+    uint64_t hash;
+    uint64_t id;
+
+    friend bool
+    operator>(const Expiry& lhs, const Expiry& rhs)
+    {
+      return lhs.expiry > rhs.expiry;
+    }
+  };
+
+  struct Filter
+  {
+    ndn::Name prefix;
+    InterestHandler onInterest;
+    ndn::RegisterPrefixFailureCallback onFailure;
+  };
+
+  void
+  connect()
+  {
+    if (m_transport->isConnected()) {
+      return;
+    }
+
+    m_transport->connect(m_io, [this] (const ndn::Block& wire) { onReceive(wire); });
+    m_transport->resume();
+    for (const auto& filter : m_filters) {
+      registerPrefix(*filter);
+    }
+  }
+
+  void
+  registerPrefix(const Filter& filter)
+  {
+    ndn::Name commandName("/localhost/nfd/rib/register");
+    commandName.append(ndn::nfd::ControlParameters().setName(filter.prefix).wireEncode());
+    auto command = ndn::security::InterestSigner(*m_keyChain).makeCommandInterest(commandName);
+    command.setInterestLifetime(std::chrono::seconds(10));
+
+    auto fail = [prefix = filter.prefix, onFailure = filter.onFailure] (const std::string& reason) {
+      if (onFailure) {
+        onFailure(prefix, reason);
+      }
+    };
+    expressInterest(command,
+      [fail] (const auto&, const ndn::Data& data) {
+        try {
+          ndn::mgmt::ControlResponse response(data.getContent().blockFromValue());
+          if (response.getCode() != 200) {
+            fail(std::to_string(response.getCode()) + " " + response.getText());
+          }
+        }
+        catch (const std::exception& e) {
+          fail(std::string("malformed response: ") + e.what());
+        }
+      },
+      [fail] (const auto&, const ndn::lp::Nack& nack) {
+        std::ostringstream os;
+        os << "Nack (" << nack.getReason() << ")";
+        fail(os.str());
+      },
+      [fail] (const auto&) { fail("timeout"); });
+  }
+
+  void
+  onReceive(const ndn::Block& wire)
+  {
+    NetworkPacket packet;
+    try {
+      packet = decodeNetworkPacket(wire);
+      switch (packet.wire.isValid() ? packet.wire.type() : 0) {
+        case ndn::tlv::Interest:
+          if (packet.nackHeader) {
+            ndn::lp::Nack nack{ndn::Interest(packet.wire)};
+            nack.setHeader(*packet.nackHeader);
+            onNack(nack);
+          }
+          else {
+            onInterest(ndn::Interest(packet.wire));
+          }
+          break;
+        case ndn::tlv::Data:
+          onData(ndn::Data(packet.wire));
+          break;
+      }
+    }
+    catch (const ndn::tlv::Error&) {
+      // like ndn::Face, silently drop malformed packets
+    }
+  }
+
+  void
+  onInterest(const ndn::Interest& interest)
+  {
+    // a handler may add filters or shut down the face
+    for (std::size_t i = 0; i < m_filters.size(); i++) {
+      auto filter = m_filters[i];
+      if (filter->prefix.isPrefixOf(interest.getName())) {
+        filter->onInterest(filter->prefix, interest);
+      }
+    }
+  }
+
+  void
+  onData(const ndn::Data& data)
+  {
+    // only Interests with CanBePrefix can be satisfied by a Data with a longer name
+    auto hashes = m_nCanBePrefix > 0 ? hashNamePrefixes(data.getName())
+                                     : std::vector<uint64_t>{hashName(data.getName())};
+    for (auto hash : hashes) {
+      auto bucket = m_pendingInterests.find(hash);
+      if (bucket == m_pendingInterests.end()) {
+        continue;
+      }
+
+      std::vector<PendingInterest> satisfied;
+      auto& entries = bucket->second;
+      for (auto it = entries.begin(); it != entries.end();) {
+        if (it->interest.matchesData(data)) {
+          satisfied.push_back(std::move(*it));
+          it = entries.erase(it);
+        }
+        else {
+          ++it;
+        }
+      }
+      if (entries.empty()) {
+        m_pendingInterests.erase(bucket);
+      }
+
+      for (auto& entry : satisfied) {
+        forget(entry);
+        entry.onData(entry.interest, data);
+      }
+    }
+  }
+
+  void
+  onNack(const ndn::lp::Nack& nack)
+  {
+    const auto& interest = nack.getInterest();
+    auto bucket = m_pendingInterests.find(hashName(interest.getName()));
+    if (bucket == m_pendingInterests.end()) {
+      return;
+    }
+
+    auto& entries = bucket->second;
+    auto it = std::find_if(entries.begin(), entries.end(), [&] (const auto& entry) {
+      return entry.interest.getNonce() == interest.getNonce() && entry.interest.getName() == interest.getName();
+    });
+    if (it == entries.end()) {
+      return;
+    }
+    auto entry = std::move(*it);
+    entries.erase(it);
+    if (entries.empty()) {
+      m_pendingInterests.erase(bucket);
+    }
+
+    forget(entry);
+    entry.onNack(entry.interest, nack);
+  }
+
+  void
+  processTimeouts()
+  {
+    auto now = std::chrono::steady_clock::now();
+    while (!m_expiries.empty() && m_expiries.top().expiry <= now) {
+      auto expired = m_expiries.top();
+      m_expiries.pop();
+
+      // the Interest may have been satisfied or Nacked in the meantime
+      auto bucket = m_pendingInterests.find(expired.hash);
+      if (bucket == m_pendingInterests.end()) {
+        continue;
+      }
+      auto& entries = bucket->second;
+      auto it = std::find_if(entries.begin(), entries.end(),
+                             [&] (const auto& entry) { return entry.id == expired.id; });
+      if (it == entries.end()) {
+        continue;
+      }
+      auto entry = std::move(*it);
+      entries.erase(it);
+      if (entries.empty()) {
+        m_pendingInterests.erase(bucket);
+      }
+
+      forget(entry);
+      entry.onTimeout(entry.interest);
+    }
+
+    if (!m_expiries.empty()) {
+      m_timeoutTimer.expires_at(m_expiries.top().expiry);
+      m_timeoutTimer.async_wait([this] (const boost::system::error_code& ec) {
+        if (!ec) {
+          processTimeouts();
+        }
+      });
+    }
+  }
+
+  void
+  forget(const PendingInterest& entry)
+  {
+    m_nPendingInterests--;
+    if (entry.interest.getCanBePrefix()) {
+      m_nCanBePrefix--;
+    }
+  }
+
+private:
+  boost::asio::io_context& m_io;
+  std::shared_ptr<BatchingTransport> m_transport;
+  ndn::KeyChain* m_keyChain;
+
+  std::unordered_map<uint64_t, std::vector<PendingInterest>> m_pendingInterests; ///< by name hash
+  std::size_t m_nPendingInterests = 0;
+  std::size_t m_nCanBePrefix = 0;
+  uint64_t m_lastPendingId = 0;
+  std::priority_queue<Expiry, std::vector<Expiry>, std::greater<>> m_expiries;
+  boost::asio::steady_timer m_timeoutTimer{m_io};
+
+  std::vector<std::shared_ptr<Filter>> m_filters;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_RAW_FACE_HPP
@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_RUN_PERIODS_HPP
+#define NDNTG_RUN_PERIODS_HPP
+
+#include "logger.hpp"
+#include "util.hpp"
+
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace ndntg {
+
+/**
+ * \brief Splits a run into a warm-up, a measurement period, and a cool-down.
+ *
+ * Packets handled during the warm-up, while the FIB and the caches are being filled, and
+ * during the cool-down, while the load winds down, are reported apart from those of the
+ * measurement period, so that the main statistics reflect the steady state. A cool-down
+ * requires the duration of the run to be known.
+ */
+class RunPeriods
+{
+public:
+  enum class Period {
+    WARMUP,
+    MEASUREMENT,
+    COOLDOWN,
+  };
+
+  /**
+   * \brief Sets up the periods from the arguments of the `--duration`, `--warmup`, and
+   *        `--cooldown` options, each of which may be empty.
+   * \throw std::invalid_argument an argument is malformed, or the periods do not fit in the run
+   */
+  static RunPeriods
+  parse(std::string_view duration, std::string_view warmup, std::string_view cooldown)
+  {
+    auto parseOption = [] (std::string_view option, std::string_view value) {
+      std::chrono::milliseconds result{0};
+      if (!value.empty() && !parseDuration(value, result)) {
+        throw std::invalid_argument("the argument for option '--" + std::string(option) +
+                                    "' must be a duration such as 500ms, 30s, 10m, or 2h");
+      }
+      return result;
+    };
+
+    RunPeriods periods;
+    periods.m_warmup = parseOption("warmup", warmup);
+    periods.m_cooldown = parseOption("cooldown", cooldown);
+    if (!duration.empty()) {
+      periods.m_duration = parseOption("duration", duration);
+      if (*periods.m_duration <= std::chrono::milliseconds::zero()) {
+        throw std::invalid_argument("the argument for option '--duration' must be positive");
+      }
+      if (periods.m_warmup + periods.m_cooldown >= *periods.m_duration) {
+        throw std::invalid_argument("the warm-up and the cool-down leave nothing of the run to measure");
+      }
+    }
+    else if (periods.m_cooldown > std::chrono::milliseconds::zero()) {
+      throw std::invalid_argument("option '--cooldown' requires '--duration'");
+    }
+    return periods;
+  }
+
+  const std::optional<std::chrono::milliseconds>&
+  getDuration() const
+  {
+    return m_duration;
+  }
+
+  /**
+   * \brief Returns whether part of the run is excluded from the measurement period.
+   */
+  bool
+  hasRamps() const
+  {
+    return m_warmup > std::chrono::milliseconds::zero() || m_cooldown > std::chrono::milliseconds::zero();
+  }
+
+  void
+  start(std::chrono::steady_clock::time_point now)
+  {
+    m_startTime = now;
+  }
+
+  /**
+   * \brief Returns the period \p time falls into; the run is measured until it is started.
+   */
+  Period
+  getPeriod(std::chrono::steady_clock::time_point time) const
+  {
+    if (!m_startTime) {
+      return Period::MEASUREMENT;
+    }
+    auto elapsed = time - *m_startTime;
+    if (elapsed < m_warmup) {
+      return Period::WARMUP;
+    }
+    if (m_duration && elapsed >= *m_duration - m_cooldown) {
+      return Period::COOLDOWN;
+    }
+    return Period::MEASUREMENT;
+  }
+
+  static std::string
+  toString(Period period)
+  {
+    switch (period) {
+      case Period::WARMUP:
+        return "Warm-up";
+      case Period::MEASUREMENT:
+        return "Measurement";
+      case Period::COOLDOWN:
+        return "Cool-down";
+    }
+    return "";
+  }
+
+  void
+  log(Logger& logger) const
+  {
+    auto format = [] (std::chrono::milliseconds duration) { return std::to_string(duration.count()) + "ms"; };
+    if (m_duration) {
+      logger.log("Run Duration                = " + format(*m_duration), false, true);
+    }
+    logger.log("Warm-up Period              = " + format(m_warmup), false, true);
+    logger.log("Cool-down Period            = " + format(m_cooldown) + "\n", false, true);
+  }
+
+private:
+  std::optional<std::chrono::milliseconds> m_duration;
+  std::chrono::milliseconds m_warmup{0};
+  std::chrono::milliseconds m_cooldown{0};
+  std::optional<std::chrono::steady_clock::time_point> m_startTime;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_RUN_PERIODS_HPP
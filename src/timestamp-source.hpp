@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_TIMESTAMP_SOURCE_HPP
+#define NDNTG_TIMESTAMP_SOURCE_HPP
+
+#include "logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NDNTG_HAVE_TSC 1
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+namespace ndntg {
+
+/**
+ * \brief Source of the timestamps from which latencies are computed.
+ *
+ * Timestamps are steady_clock time points in either case, so that they can be compared with
+ * the times at which timers expire. The MONOTONIC source simply reads steady_clock, i.e.,
+ * CLOCK_MONOTONIC on Linux. The TSC source reads the time stamp counter of the CPU, which is
+ * several times cheaper, and converts it with a rate calibrated against steady_clock. To keep
+ * both clocks in agreement, the conversion is re-anchored to steady_clock once per second,
+ * which also refines the rate over an ever longer baseline.
+ *
+ * The TSC is only used if the CPU advertises an invariant TSC, i.e., one that ticks at a
+ * constant rate in all power states. Readings on different CPUs are only comparable if their
+ * counters are synchronized, which is the case on current x86 systems; pinning the event loop
+ * to one CPU (see ExecutionMode) avoids the question altogether.
+ */
+class TimestampSource
+{
+public:
+  enum class Type {
+    MONOTONIC,
+    TSC,
+  };
+
+  /**
+   * \brief Selects the clock and calibrates it, which takes a few tens of milliseconds.
+   * \return whether \p type is used; if the TSC is not usable, MONOTONIC is used instead
+   */
+  bool
+  setType(Type type)
+  {
+    m_type = Type::MONOTONIC;
+#ifdef NDNTG_HAVE_TSC
+    if (type == Type::TSC && hasInvariantTsc()) {
+      calibrate();
+      m_type = Type::TSC;
+    }
+#endif
+    m_readCost = measureReadCost();
+    return m_type == type;
+  }
+
+  Type
+  getType() const
+  {
+    return m_type;
+  }
+
+  std::chrono::steady_clock::time_point
+  now()
+  {
+#ifdef NDNTG_HAVE_TSC
+    if (m_type == Type::TSC) {
+      return readTsc();
+    }
+#endif
+    return std::chrono::steady_clock::now();
+  }
+
+  /**
+   * \brief Logs the clock in the report of a traffic tool.
+   */
+  void
+  log(Logger& logger) const
+  {
+    char details[64];
+    if (m_type == Type::TSC) {
+      std::snprintf(details, sizeof(details), "tsc (%.3f GHz, %.1f ns per read)", 1.0 / m_nsPerTick,
+                    m_readCost.count());
+    }
+    else {
+      std::snprintf(details, sizeof(details), "monotonic (%.1f ns per read)", m_readCost.count());
+    }
+    logger.log("Clock Source                = " + std::string(details) + "\n", false, true);
+  }
+
+private:
+#ifdef NDNTG_HAVE_TSC
+  static bool
+  hasInvariantTsc()
+  {
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    return __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) != 0 && (edx & (1u << 8)) != 0;
+  }
+
+  void
+  calibrate()
+  {
+    m_startTime = std::chrono::steady_clock::now();
+    m_startTsc = __rdtsc();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    reanchor();
+    m_reanchorTicks = static_cast<uint64_t>(1e9 / m_nsPerTick);
+  }
+
+  void
+  reanchor()
+  {
+    m_anchorTime = std::chrono::steady_clock::now();
+    m_anchorTsc = __rdtsc();
+    m_nsPerTick = std::chrono::duration<double, std::nano>(m_anchorTime - m_startTime).count() /
+                  static_cast<double>(m_anchorTsc - m_startTsc);
+  }
+
+  std::chrono::steady_clock::time_point
+  readTsc()
+  {
+    auto tsc = __rdtsc();
+    // a counter that went backwards, e.g., after a migration to another CPU, also re-anchors
+    if (tsc - m_anchorTsc >= m_reanchorTicks) {
+      reanchor();
+      tsc = m_anchorTsc;
+    }
+    auto time = m_anchorTime + std::chrono::nanoseconds(static_cast<int64_t>((tsc - m_anchorTsc) * m_nsPerTick));
+    // re-anchoring can move the clock back by a few microseconds, which must not be visible
+    if (time < m_lastTime) {
+      return m_lastTime;
+    }
+    m_lastTime = time;
+    return time;
+  }
+#endif
+
+  std::chrono::duration<double, std::nano>
+  measureReadCost()
+  {
+    constexpr int N_READS = 100000;
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point last;
+    for (int i = 0; i < N_READS; i++) {
+      last = std::max(last, now());
+    }
+    return (std::chrono::steady_clock::now() - start) / static_cast<double>(N_READS);
+  }
+
+private:
+  Type m_type = Type::MONOTONIC;
+  std::chrono::duration<double, std::nano> m_readCost{0};
+  double m_nsPerTick = 1.0;
+#ifdef NDNTG_HAVE_TSC
+  std::chrono::steady_clock::time_point m_startTime;
+  uint64_t m_startTsc = 0;
+  std::chrono::steady_clock::time_point m_anchorTime;
+  uint64_t m_anchorTsc = 0;
+  uint64_t m_reanchorTicks = 0;
+  std::chrono::steady_clock::time_point m_lastTime;
+#endif
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_TIMESTAMP_SOURCE_HPP
@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_TRACE_HPP
+#define NDNTG_TRACE_HPP
+
+#include "mapped-file.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+
+namespace ndntg {
+
+/**
+ * \brief One Interest of a recorded request trace.
+ */
+struct TraceRecord
+{
+  enum Flags : uint8_t {
+    CAN_BE_PREFIX = 1 << 0,
+    MUST_BE_FRESH = 1 << 1,
+  };
+
+  /// time elapsed since the first record of the trace
+  std::chrono::microseconds offset;
+  uint8_t flags;
+  /// TLV encoding of the Interest name
+  std::string_view name;
+};
+
+/**
+ * \brief Binary trace file format.
+ *
+ * A trace file starts with the 8-byte magic string "NDNTGTRC" and a version octet,
+ * followed by records of the form
+ *
+ *     <time since previous record in microseconds> <flags octet> <name length> <name TLV>
+ *
+ * where the time and the length are unsigned LEB128 integers.
+ */
+class TraceFormat
+{
+public:
+  static constexpr std::string_view MAGIC{"NDNTGTRC"};
+  static constexpr uint8_t VERSION = 1;
+};
+
+/**
+ * \brief Writes a binary trace file.
+ */
+class TraceWriter
+{
+public:
+  explicit
+  TraceWriter(std::ostream& os)
+    : m_os(os)
+  {
+    m_os.write(TraceFormat::MAGIC.data(), TraceFormat::MAGIC.size());
+    m_os.put(static_cast<char>(TraceFormat::VERSION));
+  }
+
+  /**
+   * \pre \p offset is not smaller than the offset of the previous record
+   */
+  void
+  write(std::chrono::microseconds offset, uint8_t flags, std::string_view name)
+  {
+    writeVarNumber(static_cast<uint64_t>((offset - m_lastOffset).count()));
+    m_os.put(static_cast<char>(flags));
+    writeVarNumber(name.size());
+    m_os.write(name.data(), name.size());
+    m_lastOffset = offset;
+  }
+
+private:
+  void
+  writeVarNumber(uint64_t value)
+  {
+    do {
+      uint8_t octet = value & 0x7F;
+      value >>= 7;
+      m_os.put(static_cast<char>(value != 0 ? octet | 0x80 : octet));
+    } while (value != 0);
+  }
+
+private:
+  std::ostream& m_os;
+  std::chrono::microseconds m_lastOffset{0};
+};
+
+/**
+ * \brief Streams the records of a binary trace file.
+ *
+ * The file is memory mapped and consumed pages are periodically released, therefore
+ * traces much larger than the available memory can be replayed.
+ */
+class TraceReader
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /**
+   * \throw std::system_error the file cannot be opened
+   * \throw Error the file is not a trace file of a supported version
+   */
+  explicit
+  TraceReader(const std::string& filename)
+    : m_file(filename)
+    , m_contents(m_file.getContents())
+  {
+    if (m_contents.size() <= TraceFormat::MAGIC.size() ||
+        m_contents.substr(0, TraceFormat::MAGIC.size()) != TraceFormat::MAGIC) {
+      throw Error(filename + " is not a trace file, use ndn-traffic-trace-convert to create one");
+    }
+    auto version = static_cast<uint8_t>(m_contents[TraceFormat::MAGIC.size()]);
+    if (version != TraceFormat::VERSION) {
+      throw Error(filename + " has unsupported trace format version " + std::to_string(version));
+    }
+    m_position = TraceFormat::MAGIC.size() + 1;
+  }
+
+  /**
+   * \brief Returns the next record, or nullopt at the end of the trace.
+   * \throw Error the record is truncated
+   */
+  std::optional<TraceRecord>
+  next()
+  {
+    if (m_position == m_contents.size()) {
+      return std::nullopt;
+    }
+
+    m_offset += std::chrono::microseconds(readVarNumber());
+    if (m_position == m_contents.size()) {
+      throw Error("Truncated trace record #" + std::to_string(m_nRecords + 1));
+    }
+    auto flags = static_cast<uint8_t>(m_contents[m_position++]);
+    auto length = readVarNumber();
+    if (length > m_contents.size() - m_position) {
+      throw Error("Truncated trace record #" + std::to_string(m_nRecords + 1));
+    }
+    TraceRecord record{m_offset, flags, m_contents.substr(m_position, length)};
+    m_position += length;
+    m_nRecords++;
+
+    if (m_position - m_discarded >= DISCARD_THRESHOLD) {
+      m_file.discard(m_position);
+      m_discarded = m_position;
+    }
+    return record;
+  }
+
+  uint64_t
+  getRecordCount() const
+  {
+    return m_nRecords;
+  }
+
+private:
+  uint64_t
+  readVarNumber()
+  {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      if (m_position == m_contents.size()) {
+        break;
+      }
+      auto octet = static_cast<uint8_t>(m_contents[m_position++]);
+      value |= static_cast<uint64_t>(octet & 0x7F) << shift;
+      if ((octet & 0x80) == 0) {
+        return value;
+      }
+    }
+    throw Error("Malformed trace record #" + std::to_string(m_nRecords + 1));
+  }
+
+private:
+  static constexpr std::size_t DISCARD_THRESHOLD = 64 * 1024 * 1024;
+
+  MappedFile m_file;
+  std::string_view m_contents;
+  std::size_t m_position = 0;
+  std::size_t m_discarded = 0;
+  std::chrono::microseconds m_offset{0};
+  uint64_t m_nRecords = 0;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_TRACE_HPP
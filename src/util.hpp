@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2014-2022, Arizona Board of Regents.
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -22,46 +22,112 @@
 #define NDNTG_UTIL_HPP
 
 #include "logger.hpp"
+#include "mapped-file.hpp"
 
 #include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
 
 namespace ndntg {
 
+/**
+ * \brief Splits a configuration line of the form "Parameter=Value".
+ *
+ * The returned views refer to \p input.
+ */
 inline bool
-extractParameterAndValue(const std::string& input, std::string& parameter, std::string& value)
+extractParameterAndValue(std::string_view input, std::string_view& parameter, std::string_view& value)
 {
-  static const std::string allowedCharacters = ":/+._-%";
-  parameter = "";
-  value = "";
-
-  std::size_t i = 0;
-  // parse the parameter name
-  while (i < input.length() && input[i] != '=') {
-    parameter += input[i];
-    i++;
-  }
-  if (i == input.length()) {
+  static constexpr std::string_view allowedCharacters = ":/+._-%{},";
+
+  auto pos = input.find('=');
+  if (pos == std::string_view::npos) {
     return false;
   }
+  parameter = input.substr(0, pos);
+  value = input.substr(pos + 1);
 
-  // skip the equal sign
-  i++;
-
-  // parse the value
-  while (i < input.length() &&
-         (std::isalnum(input[i]) || allowedCharacters.find(input[i]) != std::string::npos)) {
-    value += input[i];
-    i++;
+  for (char c : value) {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && allowedCharacters.find(c) == std::string_view::npos) {
+      return false;
+    }
   }
+  return !parameter.empty() && !value.empty();
+}
 
-  return !parameter.empty() && !value.empty() && i == input.length();
+/**
+ * \brief Parses an integer that spans the whole \p input, without accepting a sign for unsigned types.
+ */
+template<typename T>
+std::enable_if_t<std::is_integral_v<T>, bool>
+parseNumber(std::string_view input, T& result)
+{
+  auto [end, ec] = std::from_chars(input.data(), input.data() + input.size(), result);
+  return ec == std::errc() && end == input.data() + input.size();
+}
+
+/**
+ * \brief Parses a finite floating point number that spans the whole \p input.
+ */
+inline bool
+parseNumber(std::string_view input, double& result)
+{
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  auto [end, ec] = std::from_chars(input.data(), input.data() + input.size(), result);
+  return ec == std::errc() && end == input.data() + input.size() && std::isfinite(result);
+#else
+  // floating point std::from_chars is not available in this standard library
+  std::string str(input);
+  char* end = nullptr;
+  errno = 0;
+  result = std::strtod(str.data(), &end);
+  return !str.empty() && errno == 0 && end == str.data() + str.size() && std::isfinite(result);
+#endif
 }
 
+/**
+ * \brief Parses a duration such as "500ms", "30s", "10m", or "2h"; a plain number is in milliseconds.
+ */
 inline bool
-parseBoolean(const std::string& input)
+parseDuration(std::string_view input, std::chrono::milliseconds& result)
+{
+  auto unitPos = input.find_first_not_of("0123456789");
+  uint64_t number = 0;
+  if (unitPos == 0 || !parseNumber(input.substr(0, unitPos), number)) {
+    return false;
+  }
+
+  auto unit = unitPos == std::string_view::npos ? std::string_view("ms") : input.substr(unitPos);
+  uint64_t factor = 0;
+  if (unit == "ms")
+    factor = 1;
+  else if (unit == "s")
+    factor = 1000;
+  else if (unit == "m")
+    factor = 60 * 1000;
+  else if (unit == "h")
+    factor = 60 * 60 * 1000;
+  else
+    return false;
+
+  if (number > static_cast<uint64_t>(std::chrono::milliseconds::max().count()) / factor) {
+    return false;
+  }
+  result = std::chrono::milliseconds(number * factor);
+  return true;
+}
+
+inline std::optional<bool>
+parseBoolean(std::string_view input)
 {
   if (boost::iequals(input, "no") || boost::iequals(input, "off") ||
       boost::iequals(input, "false") || input == "0")
@@ -71,51 +137,104 @@ parseBoolean(const std::string& input)
       boost::iequals(input, "true") || input == "1")
     return true;
 
-  throw std::invalid_argument("'" + input + "' is not a valid boolean value");
+  return std::nullopt;
 }
 
+/**
+ * \brief Logs an error found at \p lineNumber of a configuration file.
+ * \return false
+ */
+inline bool
+reportConfigurationError(Logger& logger, int lineNumber, const std::string& message)
+{
+  logger.log("Line " + std::to_string(lineNumber) + " - " + message, false, true);
+  return false;
+}
+
+/**
+ * \brief Reads a configuration file made of blocks of "Parameter=Value" lines.
+ *
+ * Blocks are separated by lines that do not start with a letter, such as comments and empty
+ * lines. Each block is parsed into a TrafficConfigurationType through its
+ * `parseConfigurationLine(parameter, value, logger, lineNumber)` method and then validated with
+ * `checkTrafficDetailCorrectness(logger, lineNumber)`, where lineNumber is the first line of the
+ * block.
+ *
+ * The file is memory mapped and parsed in a single pass. Every error in the file is reported,
+ * and no pattern is returned if any was found.
+ */
 template<typename TrafficConfigurationType>
 bool
 readConfigurationFile(const std::string& filename,
                       std::vector<TrafficConfigurationType>& patterns,
                       Logger& logger)
 {
-  std::ifstream patternFile(filename);
-  if (!patternFile) {
+  std::optional<MappedFile> file;
+  try {
+    file.emplace(filename);
+  }
+  catch (const std::system_error&) {
     logger.log("ERROR: Unable to open traffic configuration file: " + filename, false, true);
     return false;
   }
 
   logger.log("Reading traffic configuration file: " + filename, true, true);
 
-  int lineNumber = 0;
-  std::string patternLine;
-  while (getline(patternFile, patternLine)) {
-    lineNumber++;
-    if (std::isalpha(patternLine[0])) {
-      TrafficConfigurationType trafficConf;
-      bool shouldSkipLine = false;
-      if (trafficConf.parseConfigurationLine(patternLine, logger, lineNumber)) {
-        while (getline(patternFile, patternLine) && std::isalpha(patternLine[0])) {
-          lineNumber++;
-          if (!trafficConf.parseConfigurationLine(patternLine, logger, lineNumber)) {
-            shouldSkipLine = true;
-            break;
-          }
-        }
-        lineNumber++;
+  std::vector<TrafficConfigurationType> result;
+  std::optional<TrafficConfigurationType> trafficConf;
+  int firstLineNumber = 0;
+  int nErrors = 0;
+  auto finishBlock = [&] {
+    if (trafficConf) {
+      if (trafficConf->checkTrafficDetailCorrectness(logger, firstLineNumber)) {
+        result.push_back(std::move(*trafficConf));
       }
       else {
-        shouldSkipLine = true;
-      }
-      if (!shouldSkipLine) {
-        if (trafficConf.checkTrafficDetailCorrectness()) {
-          patterns.push_back(std::move(trafficConf));
-        }
+        nErrors++;
       }
+      trafficConf.reset();
     }
+  };
+
+  std::string_view contents = file->getContents();
+  int lineNumber = 0;
+  while (!contents.empty()) {
+    auto eol = contents.find('\n');
+    auto line = contents.substr(0, eol);
+    contents.remove_prefix(eol == std::string_view::npos ? contents.size() : eol + 1);
+    lineNumber++;
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+
+    if (line.empty() || !std::isalpha(static_cast<unsigned char>(line[0]))) {
+      finishBlock();
+      continue;
+    }
+    if (!trafficConf) {
+      trafficConf.emplace();
+      firstLineNumber = lineNumber;
+    }
+
+    std::string_view parameter, value;
+    if (!extractParameterAndValue(line, parameter, value)) {
+      reportConfigurationError(logger, lineNumber, "Invalid syntax: " + std::string(line));
+      nErrors++;
+    }
+    else if (!trafficConf->parseConfigurationLine(parameter, value, logger, lineNumber)) {
+      nErrors++;
+    }
+  }
+  finishBlock();
+
+  if (nErrors > 0) {
+    logger.log("ERROR: Found " + std::to_string(nErrors) + " error(s) in traffic configuration file: " +
+               filename, false, true);
+    return false;
   }
 
+  patterns.insert(patterns.end(), std::make_move_iterator(result.begin()),
+                  std::make_move_iterator(result.end()));
   return true;
 }
 
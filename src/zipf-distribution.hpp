@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_ZIPF_DISTRIBUTION_HPP
+#define NDNTG_ZIPF_DISTRIBUTION_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+namespace ndntg {
+
+/**
+ * \brief Zipf distribution over the ranks 0 .. n-1, where rank k has a probability
+ *        proportional to 1 / (k+1)^exponent.
+ *
+ * Samples are drawn with the rejection-inversion method of Hörmann and Derflinger, which
+ * needs constant time and memory regardless of n, so that very large populations do not
+ * require a precomputed table.
+ */
+class ZipfDistribution
+{
+public:
+  /**
+   * \pre n >= 1 and exponent > 0
+   */
+  ZipfDistribution(uint64_t n, double exponent)
+    : m_n(n)
+    , m_exponent(exponent)
+    , m_hIntegralX1(hIntegral(1.5) - 1.0)
+    , m_hIntegralN(hIntegral(static_cast<double>(n) + 0.5))
+    , m_s(2.0 - hIntegralInverse(hIntegral(2.5) - h(2.0)))
+  {
+  }
+
+  template<typename Engine>
+  uint64_t
+  operator()(Engine& engine) const
+  {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    while (true) {
+      double u = m_hIntegralN + dist(engine) * (m_hIntegralX1 - m_hIntegralN);
+      double x = hIntegralInverse(u);
+      double k = std::floor(x + 0.5);
+      if (k < 1.0) {
+        k = 1.0;
+      }
+      else if (k > static_cast<double>(m_n)) {
+        k = static_cast<double>(m_n);
+      }
+      if (k - x <= m_s || u >= hIntegral(k + 0.5) - h(k)) {
+        return static_cast<uint64_t>(k) - 1;
+      }
+    }
+  }
+
+  uint64_t
+  getN() const
+  {
+    return m_n;
+  }
+
+  double
+  getExponent() const
+  {
+    return m_exponent;
+  }
+
+private:
+  double
+  h(double x) const
+  {
+    return std::exp(-m_exponent * std::log(x));
+  }
+
+  double
+  hIntegral(double x) const
+  {
+    double logX = std::log(x);
+    return helper2((1.0 - m_exponent) * logX) * logX;
+  }
+
+  double
+  hIntegralInverse(double x) const
+  {
+    double t = x * (1.0 - m_exponent);
+    if (t < -1.0) {
+      t = -1.0;
+    }
+    return std::exp(helper1(t) * x);
+  }
+
+  /// log(1 + x) / x, accurate also for x close to zero
+  static double
+  helper1(double x)
+  {
+    return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+  }
+
+  /// (exp(x) - 1) / x, accurate also for x close to zero
+  static double
+  helper2(double x)
+  {
+    return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+  }
+
+private:
+  uint64_t m_n;
+  double m_exponent;
+  double m_hIntegralX1;
+  double m_hIntegralN;
+  double m_s;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_ZIPF_DISTRIBUTION_HPP
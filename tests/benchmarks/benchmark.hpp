@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_TESTS_BENCHMARKS_BENCHMARK_HPP
+#define NDNTG_TESTS_BENCHMARKS_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace ndntg::tests {
+
+/**
+ * \brief Keeps the compiler from optimizing away the computation of \p value.
+ */
+template<typename T>
+inline void
+doNotOptimize(const T& value)
+{
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+/**
+ * \brief Returns the number of iterations given as the first argument, or \p defaultValue.
+ */
+inline std::size_t
+getIterations(int argc, char** argv, std::size_t defaultValue)
+{
+  return argc > 1 ? std::strtoull(argv[1], nullptr, 10) : defaultValue;
+}
+
+inline void
+printHeader()
+{
+  std::printf("%-48s %14s %12s\n", "Benchmark", "Time", "Iterations");
+}
+
+/**
+ * \brief Runs \p f, which is given the iteration number, \p nIterations times and prints the
+ *        average time per iteration, in the manner of Google Benchmark.
+ *
+ * A tenth of the iterations is run beforehand and not timed, e.g., to fill the caches.
+ */
+template<typename F>
+void
+runBenchmark(const std::string& name, std::size_t nIterations, F&& f)
+{
+  for (std::size_t i = 0; i < nIterations / 10; i++) {
+    f(i);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < nIterations; i++) {
+    f(i);
+  }
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+  std::printf("%-48s %11.1f ns %12zu\n", name.data(), elapsed.count() / nIterations, nIterations);
+  std::fflush(stdout);
+}
+
+} // namespace ndntg::tests
+
+#endif // NDNTG_TESTS_BENCHMARKS_BENCHMARK_HPP
@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * \brief Compares the construction of generated names before and after NameEncoder.
+ *
+ * The legacy path is the one the client used before: copy the Name of the pattern, draw each
+ * random byte from a uniform_int_distribution into a separate buffer, append it as a component,
+ * and encode the name with the Interest. Both paths end with an encoded name.
+ */
+
+#include "src/name-encoder.hpp"
+#include "src/random.hpp"
+#include "tests/benchmarks/benchmark.hpp"
+
+#include <limits>
+#include <random>
+
+namespace ndntg::tests {
+
+static ndn::name::Component
+generateLegacyRandomComponent(std::size_t length)
+{
+  static std::uniform_int_distribution<unsigned> dist(std::numeric_limits<uint8_t>::min(),
+                                                      std::numeric_limits<uint8_t>::max());
+
+  ndn::Buffer buf(length);
+  for (std::size_t i = 0; i < length; i++) {
+    buf[i] = static_cast<uint8_t>(dist(random::getEngine()));
+  }
+  return ndn::name::Component(buf);
+}
+
+static void
+run(std::size_t nIterations)
+{
+  constexpr std::size_t N_RANDOM_BYTES = 32;
+  const ndn::Name prefix("/example/ndn-traffic-generator/benchmark");
+  const NameEncoder encoder(prefix);
+
+  printHeader();
+
+  runBenchmark("RandomBytes/32/uniform_int_distribution", nIterations, [] (std::size_t) {
+    doNotOptimize(generateLegacyRandomComponent(N_RANDOM_BYTES));
+  });
+  runBenchmark("RandomBytes/32/fillBytes", nIterations, [] (std::size_t) {
+    uint8_t buf[N_RANDOM_BYTES];
+    random::fillBytes(buf, sizeof(buf));
+    doNotOptimize(buf);
+  });
+
+  runBenchmark("Name/RandomSuffix32/Name::append", nIterations, [&] (std::size_t) {
+    auto name = prefix;
+    name.append(generateLegacyRandomComponent(N_RANDOM_BYTES));
+    doNotOptimize(name.wireEncode());
+  });
+  runBenchmark("Name/RandomSuffix32/NameEncoder", nIterations, [&] (std::size_t) {
+    auto name = encoder.encode(N_RANDOM_BYTES);
+    doNotOptimize(name.wireEncode());
+  });
+
+  runBenchmark("Name/RandomSuffix32+SequenceNumber/Name::append", nIterations, [&] (std::size_t i) {
+    auto name = prefix;
+    name.append(generateLegacyRandomComponent(N_RANDOM_BYTES));
+    name.appendSequenceNumber(i);
+    doNotOptimize(name.wireEncode());
+  });
+  runBenchmark("Name/RandomSuffix32+SequenceNumber/NameEncoder", nIterations, [&] (std::size_t i) {
+    auto seqNum = ndn::name::Component::fromSequenceNumber(i);
+    auto name = encoder.encode(N_RANDOM_BYTES, &seqNum);
+    doNotOptimize(name.wireEncode());
+  });
+}
+
+} // namespace ndntg::tests
+
+int
+main(int argc, char** argv)
+{
+  ndntg::tests::run(ndntg::tests::getIterations(argc, argv, 1000000));
+}
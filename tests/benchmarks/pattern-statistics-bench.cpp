@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * \brief Compares the per-Data counter updates of the client before and after the counters of
+ *        each traffic pattern were split off into a PatternStatistics block.
+ *
+ * Before, the counters were members of the pattern configuration, next to its Name and expected
+ * content, and a second set of global counters was updated for every Data as well. LegacyPattern
+ * reproduces that layout. After the split, only the PatternStatistics block of the pattern is
+ * updated, and the configuration is only read. Both variants use the same configuration fields,
+ * so that only the placement of the counters differs.
+ */
+
+#include "src/pattern-statistics.hpp"
+#include "tests/benchmarks/benchmark.hpp"
+
+#include <ndn-cxx/name.hpp>
+#include <ndn-cxx/util/time.hpp>
+
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ndntg::tests {
+
+/**
+ * \brief Configuration fields of a traffic pattern that were read on the packet path.
+ */
+struct PatternConfiguration
+{
+  double m_trafficPercentage = 0.0;
+  std::string m_name;
+  ndn::Name m_prefix;
+  std::optional<std::size_t> m_nameAppendBytes;
+  std::optional<uint64_t> m_nameAppendSeqNum;
+  bool m_canBePrefix = false;
+  bool m_mustBeFresh = false;
+  unsigned m_nonceDuplicationPercentage = 0;
+  ndn::time::milliseconds m_interestLifetime{-1};
+  uint64_t m_nextHopFaceId = 0;
+  std::optional<std::string> m_expectedContent;
+  bool m_isEnabled = true;
+};
+
+/**
+ * \brief Counters as they were kept before the split, both per pattern and globally.
+ */
+struct LegacyCounters
+{
+  uint64_t m_nInterestsSent = 0;
+  uint64_t m_nInterestsReceived = 0;
+  uint64_t m_nNacks = 0;
+  uint64_t m_nTimeouts = 0;
+  uint64_t m_nContentInconsistencies = 0;
+  double m_minimumInterestRoundTripTime = std::numeric_limits<double>::max();
+  double m_maximumInterestRoundTripTime = 0;
+  double m_totalInterestRoundTripTime = 0;
+  Histogram m_rttHistogram;
+  Histogram m_responseTimeHistogram;
+};
+
+struct LegacyPattern : PatternConfiguration, LegacyCounters
+{
+};
+
+template<typename Counters>
+void
+recordData(Counters& counters, double rtt, std::chrono::nanoseconds rttDuration,
+           std::chrono::nanoseconds responseTime)
+{
+  counters.m_nInterestsReceived++;
+  if (counters.m_minimumInterestRoundTripTime > rtt)
+    counters.m_minimumInterestRoundTripTime = rtt;
+  if (counters.m_maximumInterestRoundTripTime < rtt)
+    counters.m_maximumInterestRoundTripTime = rtt;
+  counters.m_totalInterestRoundTripTime += rtt;
+  counters.m_rttHistogram.record(rttDuration);
+  counters.m_responseTimeHistogram.record(responseTime);
+}
+
+struct Event
+{
+  uint32_t patternId;
+  std::chrono::nanoseconds rtt;
+};
+
+static void
+run(std::size_t nPatterns, std::size_t nIterations)
+{
+  // a fixed sequence of Data arrivals, for uniformly chosen patterns and with RTTs of about 1ms
+  std::mt19937 engine(1);
+  std::uniform_int_distribution<uint32_t> patternDist(0, static_cast<uint32_t>(nPatterns - 1));
+  std::lognormal_distribution<> rttDist(std::log(1e6), 0.5);
+  std::vector<Event> events(1 << 20);
+  for (auto& event : events) {
+    event = {patternDist(engine), std::chrono::nanoseconds(static_cast<int64_t>(rttDist(engine)))};
+  }
+  auto getEvent = [&] (std::size_t i) -> const Event& { return events[i & (events.size() - 1)]; };
+
+  std::vector<LegacyPattern> legacyPatterns(nPatterns);
+  LegacyCounters legacyTotals;
+  std::vector<PatternConfiguration> configurations(nPatterns);
+  std::vector<PatternStatistics> statistics(nPatterns);
+  for (std::size_t i = 0; i < nPatterns; i++) {
+    legacyPatterns[i].m_name = configurations[i].m_name = "/example/pattern/" + std::to_string(i);
+  }
+
+  auto suffix = "/" + std::to_string(nPatterns);
+  runBenchmark("onData/Legacy" + suffix, nIterations, [&] (std::size_t i) {
+    const auto& event = getEvent(i);
+    auto& pattern = legacyPatterns[event.patternId];
+    double rtt = event.rtt.count() / 1e6;
+    if (pattern.m_expectedContent) {
+      doNotOptimize(pattern.m_expectedContent);
+    }
+    recordData(legacyTotals, rtt, event.rtt, event.rtt);
+    recordData<LegacyCounters>(pattern, rtt, event.rtt, event.rtt);
+  });
+
+  // isolates the effect of the layout from that of dropping the global counters
+  runBenchmark("onData/LegacyWithoutTotals" + suffix, nIterations, [&] (std::size_t i) {
+    const auto& event = getEvent(i);
+    auto& pattern = legacyPatterns[event.patternId];
+    double rtt = event.rtt.count() / 1e6;
+    if (pattern.m_expectedContent) {
+      doNotOptimize(pattern.m_expectedContent);
+    }
+    recordData<LegacyCounters>(pattern, rtt, event.rtt, event.rtt);
+  });
+
+  runBenchmark("onData/PatternStatistics" + suffix, nIterations, [&] (std::size_t i) {
+    const auto& event = getEvent(i);
+    const auto& configuration = configurations[event.patternId];
+    double rtt = event.rtt.count() / 1e6;
+    if (configuration.m_expectedContent) {
+      doNotOptimize(configuration.m_expectedContent);
+    }
+    recordData(statistics[event.patternId], rtt, event.rtt, event.rtt);
+  });
+
+  // the price of the split: the totals are only produced by merging all blocks for a report
+  runBenchmark("Report/merge" + suffix, std::max<std::size_t>(nIterations / nPatterns, 10), [&] (std::size_t) {
+    PatternStatistics total;
+    for (const auto& stats : statistics) {
+      total.merge(stats);
+    }
+    doNotOptimize(total);
+  });
+}
+
+} // namespace ndntg::tests
+
+int
+main(int argc, char** argv)
+{
+  auto nIterations = ndntg::tests::getIterations(argc, argv, 10000000);
+  ndntg::tests::printHeader();
+  for (std::size_t nPatterns : {16, 10000}) {
+    ndntg::tests::run(nPatterns, nIterations);
+  }
+}
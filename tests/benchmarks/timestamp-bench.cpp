@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * \brief Measures the per-event cost of timestamping: reading the clock for an RTT, and logging
+ *        one line with a timestamp, for each clock source and log timestamp mode.
+ *
+ * The log lines are written to a file in a temporary directory given as NDN_TRAFFIC_LOGFOLDER,
+ * since writing them to a terminal would dominate the measurement.
+ */
+
+#include "src/logger.hpp"
+#include "src/timestamp-source.hpp"
+#include "tests/benchmarks/benchmark.hpp"
+
+#include <filesystem>
+#include <iostream>
+
+#include <stdlib.h>
+
+namespace ndntg::tests {
+
+static void
+run(std::size_t nIterations)
+{
+  for (auto type : {TimestampSource::Type::MONOTONIC, TimestampSource::Type::TSC}) {
+    TimestampSource clock;
+    if (!clock.setType(type)) {
+      std::cout << "TSC is not available, skipping its benchmarks" << std::endl;
+      continue;
+    }
+    std::string clockName = type == TimestampSource::Type::TSC ? "tsc" : "monotonic";
+
+    runBenchmark("ClockRead/" + clockName, nIterations, [&] (std::size_t) {
+      doNotOptimize(clock.now());
+    });
+
+    // an RTT measurement reads the clock when sending and when receiving
+    runBenchmark("Event/" + clockName + "/quiet", nIterations, [&] (std::size_t) {
+      auto sentTime = clock.now();
+      doNotOptimize(clock.now() - sentTime);
+    });
+
+    for (bool isCoarse : {false, true}) {
+      Logger logger("TimestampBenchmark");
+      logger.initialize(clockName + (isCoarse ? "-coarse" : "-fine"), "");
+      if (isCoarse) {
+        logger.setCoarseTimestamps();
+      }
+
+      runBenchmark("Event/" + clockName + "/log/" + (isCoarse ? "coarse" : "fine"), nIterations,
+                   [&] (std::size_t i) {
+        auto sentTime = clock.now();
+        auto rtt = clock.now() - sentTime;
+        logger.log("Data Received      - PatternType=1, GlobalID=" + std::to_string(i) +
+                   ", LocalID=" + std::to_string(i) + ", RTT=" + std::to_string(rtt.count()) + "ns",
+                   true, false);
+      });
+    }
+  }
+}
+
+} // namespace ndntg::tests
+
+int
+main(int argc, char** argv)
+{
+  char logFolder[] = "/tmp/ndntg-timestamp-bench-XXXXXX";
+  if (::mkdtemp(logFolder) == nullptr) {
+    std::cerr << "ERROR: cannot create a temporary directory for the log files" << std::endl;
+    return 2;
+  }
+  ::setenv("NDN_TRAFFIC_LOGFOLDER", logFolder, 1);
+
+  ndntg::tests::printHeader();
+  ndntg::tests::run(ndntg::tests::getIterations(argc, argv, 1000000));
+  std::filesystem::remove_all(logFolder);
+}
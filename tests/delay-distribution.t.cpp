@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/delay-distribution.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <filesystem>
+
+namespace ndntg::tests {
+
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(TestDelayDistribution)
+
+BOOST_AUTO_TEST_CASE(Constant)
+{
+  DelayDistribution delay("constant:2.5");
+  BOOST_CHECK_EQUAL(delay.toString(), "constant:2.5");
+
+  std::mt19937 engine;
+  BOOST_CHECK(delay(engine) == 2500us);
+  BOOST_CHECK(DelayDistribution("constant:0")(engine) == 0ns);
+}
+
+BOOST_AUTO_TEST_CASE(Uniform)
+{
+  DelayDistribution delay("uniform:1,3");
+  std::mt19937 engine;
+  for (int i = 0; i < 1000; i++) {
+    auto value = delay(engine);
+    BOOST_CHECK(value >= 1ms && value <= 3ms);
+  }
+  BOOST_CHECK(DelayDistribution("uniform:2,2")(engine) == 2ms);
+}
+
+BOOST_AUTO_TEST_CASE(ExponentialAndLognormal)
+{
+  std::mt19937 engine;
+  DelayDistribution exponential("exponential:10");
+  DelayDistribution lognormal("lognormal:10,0.5");
+  for (int i = 0; i < 1000; i++) {
+    BOOST_CHECK(exponential(engine) >= 0ns);
+    BOOST_CHECK(lognormal(engine) > 0ns);
+  }
+  BOOST_CHECK(DelayDistribution("exponential:0")(engine) == 0ns);
+}
+
+BOOST_AUTO_TEST_CASE(Empirical)
+{
+  std::filesystem::path dir(UNIT_TESTS_TMPDIR);
+  std::filesystem::create_directories(dir);
+  auto fileName = (dir / "delays.txt").string();
+  std::ofstream(fileName) << "# delays in milliseconds\n"
+                          << "1\n"
+                          << "\n"
+                          << "  5 \n";
+
+  DelayDistribution delay("empirical:" + fileName);
+  std::mt19937 engine;
+  bool hasSeen1 = false;
+  bool hasSeen5 = false;
+  for (int i = 0; i < 100; i++) {
+    auto value = delay(engine);
+    BOOST_CHECK(value == 1ms || value == 5ms);
+    hasSeen1 = hasSeen1 || value == 1ms;
+    hasSeen5 = hasSeen5 || value == 5ms;
+  }
+  BOOST_CHECK(hasSeen1 && hasSeen5);
+
+  std::ofstream(fileName) << "# no delays\n";
+  BOOST_CHECK_THROW(DelayDistribution("empirical:" + fileName), std::invalid_argument);
+  std::ofstream(fileName) << "1\n-2\n";
+  BOOST_CHECK_THROW(DelayDistribution("empirical:" + fileName), std::invalid_argument);
+  std::filesystem::remove(fileName);
+  BOOST_CHECK_THROW(DelayDistribution("empirical:" + fileName), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  BOOST_CHECK_THROW(DelayDistribution(""), std::invalid_argument);
+  BOOST_CHECK_THROW(DelayDistribution("10"), std::invalid_argument);
+  BOOST_CHECK_THROW(DelayDistribution("gamma:1,2"), std::invalid_argument);
+  BOOST_CHECK_THROW(DelayDistribution("constant:"), std::invalid_argument);
+  BOOST_CHECK_THROW(DelayDistribution("constant:-1"), std::invalid_argument);
+  BOOST_CHECK_THROW(DelayDistribution("constant:1ms"), std::invalid_argument);
+  BOOST_CHECK_THROW(DelayDistribution("constant:1,2"), std::invalid_argument);
+  BOOST_CHECK_THROW(DelayDistribution("uniform:1"), std::invalid_argument);
+  BOOST_CHECK_THROW(DelayDistribution("uniform:3,1"), std::invalid_argument);
+  BOOST_CHECK_THROW(DelayDistribution("lognormal:0,1"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestDelayDistribution
+
+} // namespace ndntg::tests
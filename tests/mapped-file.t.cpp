@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/mapped-file.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace ndntg::tests {
+
+class MappedFileFixture
+{
+protected:
+  MappedFileFixture()
+  {
+    std::filesystem::create_directories(UNIT_TESTS_TMPDIR);
+  }
+
+  ~MappedFileFixture()
+  {
+    std::filesystem::remove(m_fileName);
+  }
+
+protected:
+  const std::string m_fileName = std::string(UNIT_TESTS_TMPDIR) + "/mapped-file";
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestMappedFile, MappedFileFixture)
+
+BOOST_AUTO_TEST_CASE(RegularFile)
+{
+  std::ofstream(m_fileName) << "/a/b\n/a/c\n";
+  MappedFile file(m_fileName);
+  BOOST_CHECK_EQUAL(file.getContents(), "/a/b\n/a/c\n");
+  file.discard(file.getContents().size());
+
+  std::ofstream(m_fileName).close();
+  BOOST_CHECK(MappedFile(m_fileName).getContents().empty());
+}
+
+BOOST_AUTO_TEST_CASE(Fifo)
+{
+  BOOST_REQUIRE_EQUAL(::mkfifo(m_fileName.data(), 0600), 0);
+  // larger than the pipe buffer, so that it takes several reads
+  std::string contents(1024 * 1024, 'x');
+  std::thread writer([&] {
+    std::ofstream(m_fileName) << contents;
+  });
+
+  MappedFile file(m_fileName);
+  writer.join();
+  BOOST_CHECK(file.getContents() == contents);
+  file.discard(file.getContents().size());
+}
+
+BOOST_AUTO_TEST_CASE(Missing)
+{
+  BOOST_CHECK_THROW(MappedFile{m_fileName}, std::system_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestMappedFile
+
+} // namespace ndntg::tests
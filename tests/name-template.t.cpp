@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/name-template.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace ndntg::tests {
+
+BOOST_AUTO_TEST_SUITE(TestNameTemplate)
+
+BOOST_AUTO_TEST_CASE(PlainName)
+{
+  NameTemplate tpl("ndn:/a/b");
+  BOOST_CHECK(!tpl.isTemplate());
+  BOOST_CHECK_EQUAL(tpl.size(), 2);
+  BOOST_CHECK_EQUAL(tpl.getMemberCount(), 1);
+  BOOST_CHECK_EQUAL(tpl.getPrefix(), ndn::Name("/a/b"));
+  BOOST_CHECK_EQUAL(tpl.getName(0), ndn::Name("/a/b"));
+  BOOST_CHECK_EQUAL(tpl.toUri(), "/a/b");
+
+  BOOST_CHECK_EQUAL(tpl.match(ndn::Name("/a/b")).value_or(1), 0);
+  BOOST_CHECK_EQUAL(tpl.match(ndn::Name("/a/b/c")).value_or(1), 0);
+  BOOST_CHECK(!tpl.match(ndn::Name("/a")));
+  BOOST_CHECK(!tpl.match(ndn::Name("/a/c")));
+
+  BOOST_CHECK_EQUAL(NameTemplate("/").toUri(), "/");
+}
+
+BOOST_AUTO_TEST_CASE(Range)
+{
+  NameTemplate tpl("/site{0..999}/app");
+  BOOST_CHECK(tpl.isTemplate());
+  BOOST_CHECK_EQUAL(tpl.size(), 2);
+  BOOST_CHECK_EQUAL(tpl.getMemberCount(), 1000);
+  BOOST_CHECK_EQUAL(tpl.getPrefix(), ndn::Name());
+  BOOST_CHECK_EQUAL(tpl.getName(0), ndn::Name("/site0/app"));
+  BOOST_CHECK_EQUAL(tpl.getName(999), ndn::Name("/site999/app"));
+  BOOST_CHECK_EQUAL(tpl.toUri(), "/site{0..999}/app");
+
+  BOOST_CHECK_EQUAL(tpl.match(ndn::Name("/site42/app/x")).value_or(0), 42);
+  BOOST_CHECK(!tpl.match(ndn::Name("/site042/app")));
+  BOOST_CHECK(!tpl.match(ndn::Name("/site1000/app")));
+  BOOST_CHECK(!tpl.match(ndn::Name("/site/app")));
+  BOOST_CHECK(!tpl.match(ndn::Name("/site1/other")));
+}
+
+BOOST_AUTO_TEST_CASE(ZeroPadded)
+{
+  NameTemplate tpl("/p/n{008..10}x");
+  BOOST_CHECK_EQUAL(tpl.getMemberCount(), 3);
+  BOOST_CHECK_EQUAL(tpl.getPrefix(), ndn::Name("/p"));
+  BOOST_CHECK_EQUAL(tpl.getName(0), ndn::Name("/p/n008x"));
+  BOOST_CHECK_EQUAL(tpl.getName(2), ndn::Name("/p/n010x"));
+  BOOST_CHECK_EQUAL(tpl.toUri(), "/p/n{008..010}x");
+
+  BOOST_CHECK_EQUAL(tpl.match(ndn::Name("/p/n009x")).value_or(0), 1);
+  BOOST_CHECK(!tpl.match(ndn::Name("/p/n9x")));
+}
+
+BOOST_AUTO_TEST_CASE(SeveralRanges)
+{
+  NameTemplate tpl("/a{1..2}/b{0..2}");
+  BOOST_CHECK_EQUAL(tpl.getMemberCount(), 6);
+  // the first range varies fastest
+  BOOST_CHECK_EQUAL(tpl.getName(0), ndn::Name("/a1/b0"));
+  BOOST_CHECK_EQUAL(tpl.getName(1), ndn::Name("/a2/b0"));
+  BOOST_CHECK_EQUAL(tpl.getName(2), ndn::Name("/a1/b1"));
+  BOOST_CHECK_EQUAL(tpl.getName(5), ndn::Name("/a2/b2"));
+
+  for (uint64_t member = 0; member < tpl.getMemberCount(); member++) {
+    BOOST_CHECK_EQUAL(tpl.match(tpl.getName(member)).value_or(6), member);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  BOOST_CHECK_THROW(NameTemplate("/a{1..2"), std::invalid_argument);
+  BOOST_CHECK_THROW(NameTemplate("/a}1..2{"), std::invalid_argument);
+  BOOST_CHECK_THROW(NameTemplate("/a{1..2}{3..4}"), std::invalid_argument);
+  BOOST_CHECK_THROW(NameTemplate("/a{1}"), std::invalid_argument);
+  BOOST_CHECK_THROW(NameTemplate("/a{..2}"), std::invalid_argument);
+  BOOST_CHECK_THROW(NameTemplate("/a{x..2}"), std::invalid_argument);
+  BOOST_CHECK_THROW(NameTemplate("/a{2..1}"), std::invalid_argument);
+  BOOST_CHECK_THROW(NameTemplate("/a{0..18446744073709551615}"), std::invalid_argument);
+  BOOST_CHECK_THROW(NameTemplate("/a{0..4294967295}/b{0..4294967296}"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestNameTemplate
+
+} // namespace ndntg::tests
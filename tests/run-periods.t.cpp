@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/run-periods.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace ndntg::tests {
+
+using namespace std::chrono_literals;
+using Period = RunPeriods::Period;
+
+BOOST_AUTO_TEST_SUITE(TestRunPeriods)
+
+BOOST_AUTO_TEST_CASE(NoOptions)
+{
+  auto periods = RunPeriods::parse("", "", "");
+  BOOST_CHECK(!periods.getDuration());
+  BOOST_CHECK(!periods.hasRamps());
+
+  auto start = std::chrono::steady_clock::now();
+  periods.start(start);
+  BOOST_CHECK(periods.getPeriod(start) == Period::MEASUREMENT);
+  BOOST_CHECK(periods.getPeriod(start + 24h) == Period::MEASUREMENT);
+}
+
+BOOST_AUTO_TEST_CASE(Periods)
+{
+  auto periods = RunPeriods::parse("10s", "2s", "3s");
+  BOOST_REQUIRE(periods.getDuration());
+  BOOST_CHECK(*periods.getDuration() == 10s);
+  BOOST_CHECK(periods.hasRamps());
+
+  auto start = std::chrono::steady_clock::now();
+  // the whole run is measured until it is started
+  BOOST_CHECK(periods.getPeriod(start) == Period::MEASUREMENT);
+
+  periods.start(start);
+  BOOST_CHECK(periods.getPeriod(start) == Period::WARMUP);
+  BOOST_CHECK(periods.getPeriod(start + 1999ms) == Period::WARMUP);
+  BOOST_CHECK(periods.getPeriod(start + 2s) == Period::MEASUREMENT);
+  BOOST_CHECK(periods.getPeriod(start + 6999ms) == Period::MEASUREMENT);
+  BOOST_CHECK(periods.getPeriod(start + 7s) == Period::COOLDOWN);
+  BOOST_CHECK(periods.getPeriod(start + 10s) == Period::COOLDOWN);
+}
+
+BOOST_AUTO_TEST_CASE(WarmupWithoutDuration)
+{
+  auto periods = RunPeriods::parse("", "500ms", "");
+  BOOST_CHECK(periods.hasRamps());
+
+  auto start = std::chrono::steady_clock::now();
+  periods.start(start);
+  BOOST_CHECK(periods.getPeriod(start + 499ms) == Period::WARMUP);
+  BOOST_CHECK(periods.getPeriod(start + 1h) == Period::MEASUREMENT);
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  BOOST_CHECK_THROW(RunPeriods::parse("10x", "", ""), std::invalid_argument);
+  BOOST_CHECK_THROW(RunPeriods::parse("", "-1s", ""), std::invalid_argument);
+  BOOST_CHECK_THROW(RunPeriods::parse("0s", "", ""), std::invalid_argument);
+  BOOST_CHECK_THROW(RunPeriods::parse("10s", "5s", "5s"), std::invalid_argument);
+  BOOST_CHECK_THROW(RunPeriods::parse("", "", "1s"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRunPeriods
+
+} // namespace ndntg::tests
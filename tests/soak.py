@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""Soak test of the traffic tools.
+
+Runs ndn-traffic-client against ndn-traffic-server, both connected to ndn-traffic-echo
+standing in for the forwarder, for the given --duration. The memory footprint of the
+client and the server is scraped from their --metrics-socket throughout the run. Once
+the warm-up is over, the resident set size and the number of live heap allocations
+must stay flat: the test fails if their average over the last third of the samples
+exceeds their average over the first third by more than the tolerance.
+"""
+
+import argparse
+import os
+import signal
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+SERVER_CONF = '''\
+Name=/soak/server
+ContentBytes=1024
+FreshnessPeriod=0
+SigningInfo=id:/localhost/identity/digest-sha256
+'''
+
+# the second pattern is not routed, so ndn-traffic-echo answers it
+CLIENT_CONF = '''\
+TrafficPercentage=80
+Name=/soak/server
+NameAppendBytes=16
+InterestLifetime=1000
+##########
+TrafficPercentage=20
+Name=/soak/echo
+NameAppendSequenceNumber=0
+InterestLifetime=1000
+'''
+
+SERIES = ['resident_memory_bytes', 'live_heap_allocations']
+
+# growth that is always tolerated, e.g., for the allocator rounding a few more pages
+MIN_GROWTH = {
+    'resident_memory_bytes': 2 * 1024 * 1024,
+    'live_heap_allocations': 1000,
+}
+
+
+def parse_duration(value):
+    units = {'ms': 0.001, 's': 1, 'm': 60, 'h': 3600}
+    for unit in sorted(units, key=len, reverse=True):
+        if value.endswith(unit) and value[:-len(unit)].isdigit():
+            return int(value[:-len(unit)]) * units[unit]
+    if value.isdigit():
+        return int(value) / 1000
+    raise argparse.ArgumentTypeError(f'invalid duration: {value}')
+
+
+def scrape(path):
+    """Returns the samples served on the metrics socket at path, or None if it is not up."""
+    try:
+        with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as s:
+            s.settimeout(5)
+            s.connect(path)
+            s.sendall(b'metrics\n')
+            chunks = []
+            while chunk := s.recv(65536):
+                chunks.append(chunk)
+    except OSError:
+        return None
+
+    samples = {}
+    for line in b''.join(chunks).decode().splitlines():
+        if line and not line.startswith('#'):
+            name, _, value = line.rpartition(' ')
+            samples[name] = float(value)
+    return samples
+
+
+def wait_for_socket(path, process, timeout=10):
+    deadline = time.monotonic() + timeout
+    while not os.path.exists(path):
+        if process.poll() is not None or time.monotonic() > deadline:
+            sys.exit(f'ERROR: {path} was not created')
+        time.sleep(0.1)
+
+
+def stop(process, timeout=30):
+    if process.poll() is None:
+        process.send_signal(signal.SIGINT)
+        try:
+            process.wait(timeout)
+        except subprocess.TimeoutExpired:
+            process.kill()
+            process.wait()
+
+
+def check_growth(tool, samples, tolerance):
+    """Compares the first and the last third of samples and returns whether the footprint is flat."""
+    is_flat = True
+    third = len(samples) // 3
+    for series in SERIES:
+        values = [s[series] for s in samples]
+        first = sum(values[:third]) / third
+        last = sum(values[-third:]) / third
+        growth = last - first
+        limit = max(first * tolerance, MIN_GROWTH[series])
+        verdict = 'OK' if growth <= limit else 'GROWING'
+        print(f'{tool} {series}: {first:.0f} -> {last:.0f} (growth {growth:+.0f}, limit {limit:.0f}) {verdict}')
+        is_flat = is_flat and growth <= limit
+    return is_flat
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--bindir', required=True, help='directory of the built traffic tools')
+    parser.add_argument('--duration', type=parse_duration, default='10m',
+                        help='how long the client generates Interests, e.g., 30m or 2h')
+    parser.add_argument('--warmup', type=float, default=0.2,
+                        help='share of the run during which the footprint may grow')
+    parser.add_argument('--interval', default='1', help='Interest generation interval in milliseconds')
+    parser.add_argument('--tolerance', type=float, default=0.05,
+                        help='relative growth of the footprint after the warm-up that is tolerated')
+    parser.add_argument('--engine', default='face', help='packet engine of the client and the server')
+    args = parser.parse_args()
+
+    def tool(name):
+        return os.path.join(args.bindir, f'ndn-traffic-{name}')
+
+    with tempfile.TemporaryDirectory(prefix='ndntg-soak-') as tmpdir:
+        echo_socket = os.path.join(tmpdir, 'echo.sock')
+        env = dict(os.environ, HOME=tmpdir, NDN_CLIENT_TRANSPORT=f'unix://{echo_socket}')
+        env.pop('NDN_TRAFFIC_LOGFOLDER', None)
+        for name, conf in [('server', SERVER_CONF), ('client', CLIENT_CONF)]:
+            with open(os.path.join(tmpdir, f'{name}.conf'), 'w') as f:
+                f.write(conf)
+
+        def start(name, *options):
+            log = open(os.path.join(tmpdir, f'{name}.log'), 'w')
+            return subprocess.Popen([tool(name), *options], env=env, stdout=log, stderr=subprocess.STDOUT)
+
+        metrics_sockets = {name: os.path.join(tmpdir, f'{name}.metrics') for name in ['client', 'server']}
+        processes = []
+        try:
+            echo = start('echo', '-q', echo_socket)
+            processes.append(echo)
+            wait_for_socket(echo_socket, echo)
+
+            server = start('server', '-q', '--engine', args.engine,
+                           '--metrics-socket', metrics_sockets['server'], os.path.join(tmpdir, 'server.conf'))
+            processes.append(server)
+            wait_for_socket(metrics_sockets['server'], server)
+
+            client = start('client', '-q', '--engine', args.engine, '--interval', args.interval,
+                           '--max-outstanding', '10000', '--duration', f'{int(args.duration * 1000)}ms',
+                           '--metrics-socket', metrics_sockets['client'], os.path.join(tmpdir, 'client.conf'))
+            processes.append(client)
+
+            print(f'Soaking for {args.duration:.0f}s in {tmpdir}', flush=True)
+            sampling_interval = max(args.duration / 100, 1)
+            samples = {'client': [], 'server': []}
+            start_time = time.monotonic()
+            while client.poll() is None:
+                time.sleep(sampling_interval)
+                if time.monotonic() - start_time < args.duration * args.warmup:
+                    continue
+                for name, path in metrics_sockets.items():
+                    snapshot = scrape(path)
+                    if snapshot is not None:
+                        samples[name].append({s: snapshot[f'ndntg_{name}_{s}'] for s in SERIES})
+
+            # 1 only means that some Interests were not answered, e.g., while draining
+            if client.returncode not in (0, 1) or server.poll() is not None or echo.poll() is not None:
+                for name in ['echo', 'server', 'client']:
+                    print(f'--- {name}.log', open(os.path.join(tmpdir, f'{name}.log')).read()[-4000:], sep='\n')
+                sys.exit(f'ERROR: the run did not complete (client exit status {client.returncode})')
+
+            is_flat = True
+            for name, tool_samples in samples.items():
+                if len(tool_samples) < 6:
+                    sys.exit(f'ERROR: only {len(tool_samples)} samples of the {name} after the warm-up, '
+                             'use a longer --duration')
+                is_flat = check_growth(name, tool_samples, args.tolerance) and is_flat
+        finally:
+            for process in reversed(processes):
+                stop(process)
+
+    if not is_flat:
+        sys.exit('ERROR: the memory footprint keeps growing after the warm-up')
+    print('Memory footprint is flat')
+
+
+if __name__ == '__main__':
+    main()
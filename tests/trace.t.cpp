@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/trace.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace ndntg::tests {
+
+using namespace std::chrono_literals;
+
+class TraceFixture
+{
+protected:
+  TraceFixture()
+  {
+    std::filesystem::create_directories(UNIT_TESTS_TMPDIR);
+  }
+
+  ~TraceFixture()
+  {
+    std::filesystem::remove(m_fileName);
+  }
+
+  void
+  writeFile(std::string_view contents)
+  {
+    std::ofstream(m_fileName, std::ios::binary).write(contents.data(), contents.size());
+  }
+
+protected:
+  const std::string m_fileName = std::string(UNIT_TESTS_TMPDIR) + "/trace.bin";
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestTrace, TraceFixture)
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  // a name length and time deltas that need several LEB128 octets
+  std::string longName(300, '\x08');
+  {
+    std::ofstream os(m_fileName, std::ios::binary);
+    TraceWriter writer(os);
+    writer.write(0us, 0, "\x07\x03\x08\x01\x41");
+    writer.write(0us, TraceRecord::CAN_BE_PREFIX, "");
+    writer.write(20000us, TraceRecord::CAN_BE_PREFIX | TraceRecord::MUST_BE_FRESH, longName);
+    writer.write(3h, TraceRecord::MUST_BE_FRESH, std::string_view("\x07\x00", 2));
+  }
+
+  TraceReader reader(m_fileName);
+  auto record = reader.next();
+  BOOST_REQUIRE(record);
+  BOOST_CHECK(record->offset == 0us);
+  BOOST_CHECK_EQUAL(record->flags, 0);
+  BOOST_CHECK_EQUAL(record->name, std::string_view("\x07\x03\x08\x01\x41"));
+
+  record = reader.next();
+  BOOST_REQUIRE(record);
+  BOOST_CHECK(record->offset == 0us);
+  BOOST_CHECK_EQUAL(record->flags, TraceRecord::CAN_BE_PREFIX);
+  BOOST_CHECK(record->name.empty());
+
+  record = reader.next();
+  BOOST_REQUIRE(record);
+  BOOST_CHECK(record->offset == 20000us);
+  BOOST_CHECK_EQUAL(record->flags, TraceRecord::CAN_BE_PREFIX | TraceRecord::MUST_BE_FRESH);
+  BOOST_CHECK_EQUAL(record->name, longName);
+
+  record = reader.next();
+  BOOST_REQUIRE(record);
+  BOOST_CHECK(record->offset == 3h);
+  BOOST_CHECK_EQUAL(record->flags, TraceRecord::MUST_BE_FRESH);
+  BOOST_CHECK_EQUAL(record->name, std::string_view("\x07\x00", 2));
+
+  BOOST_CHECK(!reader.next());
+  BOOST_CHECK_EQUAL(reader.getRecordCount(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  {
+    std::ofstream os(m_fileName, std::ios::binary);
+    TraceWriter writer(os);
+  }
+
+  TraceReader reader(m_fileName);
+  BOOST_CHECK(!reader.next());
+  BOOST_CHECK_EQUAL(reader.getRecordCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Truncated)
+{
+  std::string header = std::string(TraceFormat::MAGIC) + char(TraceFormat::VERSION);
+
+  // the name is shorter than its length
+  writeFile(header + std::string("\x00\x00\x05\x07\x03", 5));
+  TraceReader reader(m_fileName);
+  BOOST_CHECK_THROW(reader.next(), TraceReader::Error);
+
+  // the record ends after the time delta
+  writeFile(header + std::string("\x00\x00\x00\x05", 4));
+  TraceReader reader2(m_fileName);
+  BOOST_CHECK(reader2.next());
+  BOOST_CHECK_THROW(reader2.next(), TraceReader::Error);
+
+  // the time delta does not end
+  writeFile(header + "\x80");
+  TraceReader reader3(m_fileName);
+  BOOST_CHECK_THROW(reader3.next(), TraceReader::Error);
+}
+
+BOOST_AUTO_TEST_CASE(NotATrace)
+{
+  writeFile("");
+  BOOST_CHECK_THROW(TraceReader{m_fileName}, TraceReader::Error);
+
+  writeFile("/a/b\n/a/c\n");
+  BOOST_CHECK_THROW(TraceReader{m_fileName}, TraceReader::Error);
+
+  writeFile(std::string(TraceFormat::MAGIC) + char(TraceFormat::VERSION + 1));
+  BOOST_CHECK_THROW(TraceReader{m_fileName}, TraceReader::Error);
+
+  std::filesystem::remove(m_fileName);
+  BOOST_CHECK_THROW(TraceReader{m_fileName}, std::system_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestTrace
+
+} // namespace ndntg::tests
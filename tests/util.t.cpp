@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2026, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/util.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace ndntg::tests {
+
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(TestUtil)
+
+BOOST_AUTO_TEST_CASE(ParseIntegral)
+{
+  int i = 0;
+  BOOST_CHECK(parseNumber("42", i));
+  BOOST_CHECK_EQUAL(i, 42);
+  BOOST_CHECK(parseNumber("-7", i));
+  BOOST_CHECK_EQUAL(i, -7);
+  BOOST_CHECK(!parseNumber("", i));
+  BOOST_CHECK(!parseNumber("42 ", i));
+  BOOST_CHECK(!parseNumber("4x2", i));
+
+  uint8_t u8 = 0;
+  BOOST_CHECK(parseNumber("255", u8));
+  BOOST_CHECK_EQUAL(u8, 255);
+  BOOST_CHECK(!parseNumber("256", u8));
+  BOOST_CHECK(!parseNumber("-1", u8));
+}
+
+BOOST_AUTO_TEST_CASE(ParseDouble)
+{
+  double d = 0;
+  BOOST_CHECK(parseNumber("0.5", d));
+  BOOST_CHECK_EQUAL(d, 0.5);
+  BOOST_CHECK(parseNumber("-2", d));
+  BOOST_CHECK_EQUAL(d, -2.0);
+  BOOST_CHECK(parseNumber("1e3", d));
+  BOOST_CHECK_EQUAL(d, 1000.0);
+  BOOST_CHECK(!parseNumber("", d));
+  BOOST_CHECK(!parseNumber("0.5s", d));
+  BOOST_CHECK(!parseNumber("inf", d));
+  BOOST_CHECK(!parseNumber("nan", d));
+}
+
+BOOST_AUTO_TEST_CASE(ParseDuration)
+{
+  std::chrono::milliseconds ms{0};
+  BOOST_CHECK(parseDuration("250", ms));
+  BOOST_CHECK(ms == 250ms);
+  BOOST_CHECK(parseDuration("500ms", ms));
+  BOOST_CHECK(ms == 500ms);
+  BOOST_CHECK(parseDuration("30s", ms));
+  BOOST_CHECK(ms == 30s);
+  BOOST_CHECK(parseDuration("10m", ms));
+  BOOST_CHECK(ms == 10min);
+  BOOST_CHECK(parseDuration("2h", ms));
+  BOOST_CHECK(ms == 2h);
+  BOOST_CHECK(parseDuration("0s", ms));
+  BOOST_CHECK(ms == 0ms);
+
+  ms = 1ms;
+  BOOST_CHECK(!parseDuration("", ms));
+  BOOST_CHECK(!parseDuration("s", ms));
+  BOOST_CHECK(!parseDuration("-1s", ms));
+  BOOST_CHECK(!parseDuration("1.5s", ms));
+  BOOST_CHECK(!parseDuration("10d", ms));
+  BOOST_CHECK(!parseDuration("10 s", ms));
+  BOOST_CHECK(!parseDuration("18446744073709551615h", ms));
+  BOOST_CHECK(!parseDuration("99999999999999999999", ms));
+  BOOST_CHECK(ms == 1ms);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestUtil
+
+} // namespace ndntg::tests